@@ -19,9 +19,17 @@ cdef extern from "ym/MinCov.h" namespace "nsYm" :
         void set_size(int, int)
         void set_col_cost(int, int)
         void insert_elem(int, int)
+        void load_csr(const vector[int]&, const vector[int]&, const vector[int]&)
+        void load_coo(int, const vector[int]&, const vector[int]&, const vector[int]&)
         int exact(vector[int]&)
+        int exact(vector[int]&, int)
+        int exact_portfolio(vector[int]&)
         int heuristic(vector[int]&)
         int heuristic(const string&, vector[int]&)
         void set_partition_flag(bool)
         void set_debug_flag(bool)
         void set_max_depth(int)
+        void set_thread_num(int)
+        void set_parallel_lb(bool)
+        void set_lb_list(const vector[string]&)
+        void set_mis_ls_iter_num(int)
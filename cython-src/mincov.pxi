@@ -44,11 +44,46 @@ cdef class MinCov :
     def insert_elem(MinCov self, int row_pos, int col_pos) :
         self._this.insert_elem(row_pos, col_pos)
 
+    ### @brief CSR 形式で問題を設定する．
+    ### @param[in] row_ptr 各行の要素の開始位置のリスト ( サイズは行数 + 1 )
+    ### @param[in] col_idx 要素の列番号のリスト
+    ### @param[in] col_cost_list 列のコストのリスト ( サイズは列数 )
+    def load_csr(MinCov self, row_ptr, col_idx, col_cost_list) :
+        cdef vector[int] c_row_ptr = row_ptr
+        cdef vector[int] c_col_idx = col_idx
+        cdef vector[int] c_col_cost = col_cost_list
+        self._this.load_csr(c_row_ptr, c_col_idx, c_col_cost)
+
+    ### @brief COO 形式で問題を設定する．
+    ### @param[in] row_size 行数
+    ### @param[in] row_idx 要素の行番号のリスト
+    ### @param[in] col_idx 要素の列番号のリスト ( サイズは row_idx と同じ )
+    ### @param[in] col_cost_list 列のコストのリスト ( サイズは列数 )
+    def load_coo(MinCov self, int row_size, row_idx, col_idx, col_cost_list) :
+        cdef vector[int] c_row_idx = row_idx
+        cdef vector[int] c_col_idx = col_idx
+        cdef vector[int] c_col_cost = col_cost_list
+        self._this.load_coo(row_size, c_row_idx, c_col_idx, c_col_cost)
+
     ### @brief 最小被覆問題の厳密解を求める．
+    ### @param[in] thread_num 探索に用いるスレッド数
+    ### @return 解のコストと解の列のリストのタプル
+    ###
+    ### thread_num が 2 以上の時はスレッドを全て探索に用いるので
+    ### set_thread_num() の値は用いない．
+    def exact(MinCov self, int thread_num = 1) :
+        cdef vector[int] c_solution
+        cdef int cost = self._this.exact(c_solution, thread_num)
+        solution = list()
+        for i in range(c_solution.size()) :
+            solution.append(c_solution[i])
+        return cost, solution
+
+    ### @brief 複数の設定を並列に走らせて最小被覆問題の厳密解を求める．
     ### @return 解のコストと解の列のリストのタプル
-    def exact(MinCov self) :
+    def exact_portfolio(MinCov self) :
         cdef vector[int] c_solution
-        cdef int cost = self._this.exact(c_solution)
+        cdef int cost = self._this.exact_portfolio(c_solution)
         solution = list()
         for i in range(c_solution.size()) :
             solution.append(c_solution[i])
@@ -76,3 +111,35 @@ cdef class MinCov :
     ### デバッグフラグが False の時は意味を持たない．
     def set_max_depth(MinCov self, int depth) :
         self._this.set_max_depth(depth)
+
+    ### @brief 並列処理に用いるスレッド数を設定する．
+    ### @param[in] num スレッド数
+    ###
+    ### 簡単化の支配関係の検出とブロック分割後の各ブロックの探索に用いる．
+    ### 1 以下の時は並列化を行わない．
+    ### exact() の thread_num が 2 以上の時は用いない．
+    def set_thread_num(MinCov self, int num) :
+        self._this.set_thread_num(num)
+
+    ### @brief 下界の計算を並列に行うかを設定する．
+    ### @param[in] flag 並列に計算する時 true にする．
+    def set_parallel_lb(MinCov self, bool flag) :
+        self._this.set_parallel_lb(flag)
+
+    ### @brief exact() で用いる下界の計算方法を設定する．
+    ### @param[in] name_list 下界の計算方法の名前のリスト
+    ###
+    ### 名前は 'cs', 'mis1', 'mis2', 'mis3', 'lagrangian', 'dual' のいずれか．
+    ### 軽いものから順に並べること．
+    def set_lb_list(MinCov self, name_list) :
+        cdef vector[string] c_name_list
+        for name in name_list :
+            c_name_list.push_back(name.encode('UTF-8'))
+        self._this.set_lb_list(c_name_list)
+
+    ### @brief MIS 下界の局所探索の反復回数を設定する．
+    ### @param[in] iter_num 反復回数
+    ###
+    ### 'mis1', 'mis2' の下界に適用される．0 の時は局所探索を行わない．
+    def set_mis_ls_iter_num(MinCov self, int iter_num) :
+        self._this.set_mis_ls_iter_num(iter_num)
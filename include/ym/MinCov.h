@@ -17,6 +17,9 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class MinCov MinCov.h "ym/MinCov.h"
 /// @brief 最小被覆問題を解くクラス
+///
+/// オプションや作業領域はオブジェクトごとに持つので，
+/// 異なるオブジェクトを別々のスレッドで同時に解いてもよい．
 //////////////////////////////////////////////////////////////////////
 class MinCov
 {
@@ -55,12 +58,65 @@ public:
   insert_elem(int row_pos,
 	      int col_pos);
 
+  /// @brief CSR 形式で問題を設定する．
+  /// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは行数 + 1 )
+  /// @param[in] col_idx 要素の列番号の配列 ( サイズは row_ptr の末尾の値 )
+  /// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+  ///
+  /// i 行目の要素の列番号は col_idx[row_ptr[i]] から col_idx[row_ptr[i + 1] - 1]
+  /// までとなる．
+  /// set_size(), set_col_cost(), insert_elem() を個別に呼ぶのと同じ結果になるが，
+  /// 要素数が多い場合にはこちらのほうが高速である．
+  void
+  load_csr(const vector<int>& row_ptr,
+	   const vector<int>& col_idx,
+	   const vector<int>& col_cost_array);
+
+  /// @brief COO 形式で問題を設定する．
+  /// @param[in] row_size 行数
+  /// @param[in] row_idx 要素の行番号の配列
+  /// @param[in] col_idx 要素の列番号の配列 ( サイズは row_idx と同じ )
+  /// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+  ///
+  /// 要素の順序は任意で，重複は無視される．
+  void
+  load_coo(int row_size,
+	   const vector<int>& row_idx,
+	   const vector<int>& col_idx,
+	   const vector<int>& col_cost_array);
+
   /// @brief 最小被覆問題を解く．
   /// @param[out] solution 選ばれた列集合
   /// @return 解のコスト
   int
   exact(vector<int>& solution);
 
+  /// @brief 複数のスレッドで最小被覆問題を解く．
+  /// @param[out] solution 選ばれた列集合
+  /// @param[in] thread_num 探索に用いるスレッド数
+  /// @return 解のコスト
+  ///
+  /// 探索木の部分木をタスクとして work stealing 方式で
+  /// 複数のスレッドに分配する．暫定解は全てのスレッドで共有される．
+  /// thread_num が 1 以下の時は exact(solution) と同じ．
+  ///
+  /// thread_num が 2 以上の時は使うスレッドはちょうど thread_num 個で，
+  /// 全て探索に用いる．set_thread_num() の値はこの時は用いず，
+  /// 簡単化とブロック分割後の探索は各スレッドの中で逐次に行う．
+  int
+  exact(vector<int>& solution,
+	int thread_num);
+
+  /// @brief 複数の設定を並列に走らせて最小被覆問題を解く．
+  /// @param[out] solution 選ばれた列集合
+  /// @return 解のコスト
+  ///
+  /// 下界の計算方法と分岐する列の選び方の異なる組み合わせを
+  /// 別々のスレッドで走らせる．暫定解は共有され，いずれかが
+  /// 最適性を証明した時点で全体を打ち切る．
+  int
+  exact_portfolio(vector<int>& solution);
+
   /// @brief ヒューリスティックで最小被覆問題を解く．
   /// @param[out] solution 選ばれた列集合
   /// @return 解のコスト
@@ -77,6 +133,20 @@ public:
   heuristic(const string& algorithm,
 	    vector<int>& solution);
 
+  /// @brief ヒューリスティックで最小被覆問題を解き，下界も求める．
+  /// @param[in] algorithm ヒューリスティックの名前
+  /// @param[out] solution 選ばれた列集合
+  /// @param[out] lower_bound 最適解のコストの下界
+  /// @return 解のコスト
+  ///
+  /// "lagrangian" の場合はラグランジュ緩和で得られた最良の下界を，
+  /// それ以外の場合は exact() で用いる下界の計算結果を lower_bound に入れる．
+  /// 返り値と lower_bound が等しければ solution は最適解である．
+  int
+  heuristic(const string& algorithm,
+	    vector<int>& solution,
+	    int& lower_bound);
+
   /// @brief partition フラグを設定する．
   /// @param[in] flag 分割を行う時 true にセットする．
   void
@@ -94,6 +164,52 @@ public:
   void
   set_max_depth(int depth);
 
+  /// @brief 並列処理に用いるスレッド数を設定する．
+  /// @param[in] num スレッド数
+  ///
+  /// 簡単化の支配関係の検出とブロック分割後の各ブロックの探索に用いる．
+  /// 1 以下の時は並列化を行わない(デフォルト)．
+  /// exact(solution, thread_num) で thread_num が 2 以上の時は
+  /// スレッドを全て探索に用いるので，この値は用いない．
+  /// 解のコストはスレッド数によらないが，
+  /// 同じコストの解が複数ある場合にどれが選ばれるかは変わりうる．
+  void
+  set_thread_num(int num);
+
+  /// @brief 下界の計算を並列に行うかを設定する．
+  /// @param[in] flag 並列に計算する時 true にセットする．
+  ///
+  /// 軽い下界で枝刈りできなかった場合に，残りの下界を
+  /// 別々のスレッドで同時に計算する．デフォルトは false
+  void
+  set_parallel_lb(bool flag);
+
+  /// @brief exact() で用いる下界の計算方法を設定する．
+  /// @param[in] name_list 下界の計算方法の名前のリスト
+  ///
+  /// 全ての下界の最大値を用いる．枝刈りできた時点で残りは
+  /// 計算しないので，軽いものから順に並べること．
+  /// 名前は以下のいずれか．知らない名前は無視する．
+  /// - "cs"         : column splitting
+  /// - "mis1"       : 重みなしの最大独立集合(貪欲法)
+  /// - "mis2"       : 重みつきの最大独立集合(貪欲法)
+  /// - "mis3"       : 重みつきの最大独立集合(分枝限定法)
+  /// - "lagrangian" : ラグランジュ緩和
+  /// - "dual"       : 双対上昇法
+  ///
+  /// デフォルトは { "cs", "mis1" }
+  void
+  set_lb_list(const vector<string>& name_list);
+
+  /// @brief MIS 下界の局所探索の反復回数を設定する．
+  /// @param[in] iter_num 反復回数
+  ///
+  /// "mis1", "mis2" の下界で貪欲法で求めた独立集合を
+  /// 局所探索で改善する．反復回数を増やすと下界は強くなるが
+  /// 計算時間も増える．デフォルトは 0 (局所探索を行わない)
+  void
+  set_mis_ls_iter_num(int iter_num);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
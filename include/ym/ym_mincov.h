@@ -33,6 +33,7 @@ BEGIN_NAMESPACE_YM_MINCOV
 
 class MinCov;
 class LbCalc;
+class LbMAX;
 class Selector;
 class McSolver;
 class McSolverImpl;
@@ -40,6 +41,13 @@ class McCell;
 class McRowHead;
 class McColHead;
 class McMatrix;
+class McMatrixListener;
+class McConflictGraph;
+class McRowWeight;
+class McColScore;
+struct McOption;
+class McIncumbent;
+class McTaskPool;
 
 END_NAMESPACE_YM_MINCOV
 
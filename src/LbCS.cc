@@ -9,6 +9,7 @@
 
 #include "LbCS.h"
 #include "McMatrix.h"
+#include "McRowWeight.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -24,6 +25,52 @@ int
 LbCS::operator()(const McMatrix& matrix)
 {
   double cost = 0.0;
+  const McRowWeight* row_weight = matrix.row_weight();
+  if ( row_weight != nullptr ) {
+    cost = row_weight->sum();
+  }
+  else {
+    vector<double> weight_array(matrix.row_size());
+    row_weights(matrix, weight_array);
+    for ( const McRowHead* row = matrix.row_front();
+	  !matrix.is_row_end(row); row = row->next() ) {
+      cost += weight_array[row->pos()];
+    }
+  }
+  return ceil_lb(cost);
+}
+
+// @brief 自身の複製を作る．
+LbCalc*
+LbCS::clone() const
+{
+  return new LbCS();
+}
+
+// @brief column splitting の行の重みを用いる時 true を返す．
+bool
+LbCS::need_row_weight() const
+{
+  return true;
+}
+
+// @brief 各行の重みを求める．
+// @param[in] matrix 対象の行列
+// @param[out] weight_array 各行の重みを入れる配列
+void
+LbCS::row_weights(const McMatrix& matrix,
+		  vector<double>& weight_array)
+{
+  ASSERT_COND( static_cast<int>(weight_array.size()) >= matrix.row_size() );
+  const McRowWeight* row_weight = matrix.row_weight();
+  if ( row_weight != nullptr ) {
+    for ( const McRowHead* row = matrix.row_front();
+	  !matrix.is_row_end(row); row = row->next() ) {
+      int row_pos = row->pos();
+      weight_array[row_pos] = row_weight->weight(row_pos);
+    }
+    return;
+  }
   for ( const McRowHead* row = matrix.row_front();
 	!matrix.is_row_end(row); row = row->next() ) {
     double min_cost = DBL_MAX;
@@ -35,11 +82,8 @@ LbCS::operator()(const McMatrix& matrix)
 	min_cost = col_cost;
       }
     }
-    cost += min_cost;
+    weight_array[row->pos()] = min_cost;
   }
-  cost = ceil(cost);
-
-  return static_cast<int>(cost);
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -17,6 +17,9 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class LbCS LbCS.h "LbCS.h"
 /// @brief column splitting を用いた下界の計算クラス
+///
+/// 行列が McRowWeight を持っていれば，差分更新されている重みの和を
+/// そのまま用いるので行列を走査しない．
 //////////////////////////////////////////////////////////////////////
 class LbCS :
   public LbCalc
@@ -31,6 +34,30 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 自身の複製を作る．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief column splitting の行の重みを用いる時 true を返す．
+  virtual
+  bool
+  need_row_weight() const;
+
+  /// @brief 各行の重みを求める．
+  /// @param[in] matrix 対象の行列
+  /// @param[out] weight_array 各行の重みを入れる配列
+  ///
+  /// 行の重みはその行を含む列のコストを列の要素数で割った値の最小値．
+  /// 削除されていない行の値のみ設定する．
+  /// 行列が McRowWeight を持っていればその値を写す．
+  /// 重みの和が column splitting の下界になり，各行の重みは
+  /// 実行可能な双対解にもなっている．
+  static
+  void
+  row_weights(const McMatrix& matrix,
+	      vector<double>& weight_array);
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -37,8 +37,129 @@ public:
   int
   operator()(const McMatrix& matrix) = 0;
 
+  /// @brief 打ち切りの値を指定して下界の計算をする．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] limit 打ち切りの値
+  ///
+  /// 下界が limit 以上になることが分かった時点で計算を打ち切ってよい．
+  /// その場合も返り値は下界になっている．
+  /// デフォルトでは limit を無視して operator()(matrix) を呼ぶ．
+  virtual
+  int
+  operator()(const McMatrix& matrix,
+	     int limit);
+
+  /// @brief 自身の複製を作る．
+  ///
+  /// 並列に探索する時にスレッドごとに別のオブジェクトを用いるためのもの
+  virtual
+  LbCalc*
+  clone() const = 0;
+
+  /// @brief 行の衝突グラフを用いる時 true を返す．
+  ///
+  /// true を返すクラスを用いる McSolverImpl は行列に
+  /// McMatrix::make_conflict_graph() で衝突グラフを持たせる．
+  /// デフォルトでは false を返す．
+  virtual
+  bool
+  need_conflict_graph() const;
+
+  /// @brief column splitting の行の重みを用いる時 true を返す．
+  ///
+  /// true を返すクラスを用いる McSolverImpl は行列に
+  /// McMatrix::make_row_weight() で行の重みを持たせる．
+  /// デフォルトでは false を返す．
+  virtual
+  bool
+  need_row_weight() const;
+
+  /// @brief 直前の計算で得られた列の縮約コストを返す．
+  /// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+  /// @param[out] rc_array 各列の縮約コストを入れる配列
+  /// @return 縮約コストが得られない時は false を返す．
+  ///
+  /// 下界を双対解(または乗数)から求めるクラスが用いる．
+  /// 直前に計算した行列の削除されていない列の値のみ意味を持つ．
+  /// 列 j を選ぶ解のコストは lb + rc_array[j] 以上になる．
+  /// デフォルトでは false を返す．
+  virtual
+  bool
+  get_reduced_cost(double& lb,
+		   vector<double>& rc_array) const;
+
+  /// @brief 実数の下界を整数の下界に切り上げる．
+  /// @param[in] lb 実数の下界
+  ///
+  /// 丸め誤差で真の値を超えないように LB_EPS だけ引いてから切り上げる．
+  static
+  int
+  ceil_lb(double lb);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 定数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ceil_lb() で切り上げる前に引く値
+  static constexpr double LB_EPS = 1.0e-6;
+
 };
 
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 打ち切りの値を指定して下界の計算をする．
+// @param[in] matrix 対象の行列
+// @param[in] limit 打ち切りの値
+inline
+int
+LbCalc::operator()(const McMatrix& matrix,
+		   int)
+{
+  return (*this)(matrix);
+}
+
+// @brief 行の衝突グラフを用いる時 true を返す．
+inline
+bool
+LbCalc::need_conflict_graph() const
+{
+  return false;
+}
+
+// @brief column splitting の行の重みを用いる時 true を返す．
+inline
+bool
+LbCalc::need_row_weight() const
+{
+  return false;
+}
+
+// @brief 直前の計算で得られた列の縮約コストを返す．
+// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+// @param[out] rc_array 各列の縮約コストを入れる配列
+inline
+bool
+LbCalc::get_reduced_cost(double&,
+			 vector<double>&) const
+{
+  return false;
+}
+
+// @brief 実数の下界を整数の下界に切り上げる．
+// @param[in] lb 実数の下界
+inline
+int
+LbCalc::ceil_lb(double lb)
+{
+  return static_cast<int>(ceil(lb - LB_EPS));
+}
+
 END_NAMESPACE_YM_MINCOV
 
 
@@ -0,0 +1,137 @@
+﻿
+/// @file LbDual.cc
+/// @brief LbDual の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LbDual.h"
+#include "LbCS.h"
+#include "McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス LbDual
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LbDual::LbDual() :
+  mLb(0.0),
+  mValid(false)
+{
+}
+
+// @brief デストラクタ
+LbDual::~LbDual()
+{
+}
+
+// @brief 下限を求める．
+// @param[in] matrix 対象の行列
+// @return 下限値
+int
+LbDual::operator()(const McMatrix& matrix)
+{
+  mValid = false;
+  if ( matrix.row_num() == 0 ) {
+    return 0;
+  }
+
+  // column splitting の重みから始める．
+  mDual.resize(matrix.row_size());
+  LbCS::row_weights(matrix, mDual);
+
+  // 各列の縮約コストを求める．
+  mRcArray.resize(matrix.col_size());
+  for ( const McColHead* col = matrix.col_front();
+	!matrix.is_col_end(col); col = col->next() ) {
+    double rc = matrix.col_cost(col->pos());
+    for ( const McCell* cell = col->front();
+	  !col->is_end(cell); cell = cell->col_next() ) {
+      rc -= mDual[cell->row_pos()];
+    }
+    // 丸め誤差で負になった時は 0 にしておく．
+    mRcArray[col->pos()] = rc > 0.0 ? rc : 0.0;
+  }
+
+  // 要素数の少ない行ほど増やせる量が制限されにくいので先に処理する．
+  // 要素数で数え上げソートする．
+  int max_num = 0;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    max_num = std::max(max_num, row->num());
+  }
+  mCountArray.assign(max_num + 2, 0);
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    ++ mCountArray[row->num() + 1];
+  }
+  for ( int i = 1; i <= max_num + 1; ++ i ) {
+    mCountArray[i] += mCountArray[i - 1];
+  }
+  mRowList.resize(matrix.row_num());
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    mRowList[mCountArray[row->num()] ++] = row->pos();
+  }
+
+  // 各行の双対変数をその行を含む列の縮約コストの最小値だけ増やす．
+  for ( auto row_pos: mRowList ) {
+    const McRowHead* row = matrix.row(row_pos);
+    double delta = DBL_MAX;
+    for ( const McCell* cell = row->front();
+	  !row->is_end(cell); cell = cell->row_next() ) {
+      delta = std::min(delta, mRcArray[cell->col_pos()]);
+    }
+    if ( delta <= 0.0 ) {
+      continue;
+    }
+    mDual[row_pos] += delta;
+    for ( const McCell* cell = row->front();
+	  !row->is_end(cell); cell = cell->row_next() ) {
+      double& rc = mRcArray[cell->col_pos()];
+      rc -= delta;
+      if ( rc < 0.0 ) {
+	rc = 0.0;
+      }
+    }
+  }
+
+  double lb = 0.0;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    lb += mDual[row->pos()];
+  }
+  mLb = lb;
+  mValid = true;
+
+  return ceil_lb(lb);
+}
+
+// @brief 自身の複製を作る．
+LbCalc*
+LbDual::clone() const
+{
+  return new LbDual();
+}
+
+// @brief 直前の計算で得られた列の縮約コストを返す．
+// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+// @param[out] rc_array 各列の縮約コストを入れる配列
+bool
+LbDual::get_reduced_cost(double& lb,
+			 vector<double>& rc_array) const
+{
+  if ( !mValid ) {
+    return false;
+  }
+  lb = mLb;
+  rc_array = mRcArray;
+  return true;
+}
+
+END_NAMESPACE_YM_MINCOV
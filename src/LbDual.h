@@ -0,0 +1,93 @@
+﻿#ifndef LBDUAL_H
+#define LBDUAL_H
+
+/// @file LbDual.h
+/// @brief LbDual のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LbCalc.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class LbDual LbDual.h "LbDual.h"
+/// @brief 双対上昇法(dual ascent)を用いた下界の計算クラス
+///
+/// LbCS の各行の重みは LP 緩和の実行可能な双対解になっているので，
+/// そこから各行の双対変数をその行を含む列の縮約コストの最小値だけ
+/// 増やしていく．増やした行は縮約コストが 0 の列を持つようになり，
+/// 縮約コストは減る一方なので全ての行を一度ずつ処理すれば
+/// それ以上どの行も増やせない双対解になる．
+/// 双対変数の和は LbCS の値以上の下界になる．
+//////////////////////////////////////////////////////////////////////
+class LbDual :
+  public LbCalc
+{
+public:
+
+  /// @brief コンストラクタ
+  LbDual();
+
+  /// @brief デストラクタ
+  virtual
+  ~LbDual();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 下界の計算をする
+  virtual
+  int
+  operator()(const McMatrix& matrix);
+
+  /// @brief 自身の複製を作る．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief 直前の計算で得られた列の縮約コストを返す．
+  /// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+  /// @param[out] rc_array 各列の縮約コストを入れる配列
+  /// @return 縮約コストが得られない時は false を返す．
+  virtual
+  bool
+  get_reduced_cost(double& lb,
+		   vector<double>& rc_array) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 各行の双対変数の配列
+  vector<double> mDual;
+
+  // 各列の縮約コストの配列
+  vector<double> mRcArray;
+
+  // 行を要素数の昇順に並べたリスト
+  vector<int> mRowList;
+
+  // 要素数ごとの行の数(の累積)を数えるための配列
+  vector<int> mCountArray;
+
+  // 直前の計算で得られた下界(切り上げ前の値)
+  double mLb;
+
+  // mRcArray が有効な時 true となるフラグ
+  bool mValid;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // LBDUAL_H
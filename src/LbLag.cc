@@ -0,0 +1,284 @@
+﻿
+/// @file LbLag.cc
+/// @brief LbLag の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LbLag.h"
+#include "McMatrix.h"
+#include "LbCS.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス LbLag
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LbLag::LbLag() :
+  mIterNum(10),
+  mInitIterNum(50),
+  mBestLb(0.0),
+  mValid(false)
+{
+}
+
+// @brief デストラクタ
+LbLag::~LbLag()
+{
+}
+
+// @brief 下限を求める．
+// @param[in] matrix 対象の行列
+// @return 下限値
+int
+LbLag::operator()(const McMatrix& matrix)
+{
+  return (*this)(matrix, INT_MAX);
+}
+
+// @brief 打ち切りの値を指定して下界の計算をする．
+// @param[in] matrix 対象の行列
+// @param[in] limit 打ち切りの値
+int
+LbLag::operator()(const McMatrix& matrix,
+		  int limit)
+{
+  mValid = false;
+  if ( matrix.row_num() == 0 ) {
+    return 0;
+  }
+
+  int iter_num = mIterNum;
+  if ( static_cast<int>(mMult.size()) != matrix.row_size() ) {
+    init_mult(matrix);
+    iter_num = mInitIterNum;
+  }
+  mSubgrad.resize(matrix.row_size());
+  mRcArray.resize(matrix.col_size());
+  mBestRcArray.resize(matrix.col_size());
+
+  // 劣勾配法の目標値
+  // 各行を最小コストの列で被覆した時のコスト(上界になっている)と
+  // 打ち切りの値の小さい方を用いる．
+  // 暫定解のない間の打ち切りの値は INT_MAX に近い値になるので
+  // そのまま用いると歩幅が大きくなりすぎる．
+  double target = 0.0;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    int min_cost = INT_MAX;
+    for ( const McCell* cell = row->front();
+	  !row->is_end(cell); cell = cell->row_next() ) {
+      min_cost = std::min(min_cost, matrix.col_cost(cell->col_pos()));
+    }
+    target += min_cost;
+  }
+  if ( target > limit ) {
+    target = limit;
+  }
+
+  // 最初の反復の値は必ず記録するので mBestMult と mBestRcArray は
+  // 常にこの行列に対する値となる．
+  double best = -DBL_MAX;
+  double step_factor = 2.0;
+  int fail_count = 0;
+  for ( int iter = 0; ; ++ iter ) {
+    double val = eval(matrix, mMult, mRcArray, mSubgrad);
+    bool improved = best < val;
+    if ( improved ) {
+      best = val;
+      for ( const McRowHead* row = matrix.row_front();
+	    !matrix.is_row_end(row); row = row->next() ) {
+	mBestMult[row->pos()] = mMult[row->pos()];
+      }
+      for ( const McColHead* col = matrix.col_front();
+	    !matrix.is_col_end(col); col = col->next() ) {
+	mBestRcArray[col->pos()] = mRcArray[col->pos()];
+      }
+    }
+    update_step(improved, 2, fail_count, step_factor);
+
+    if ( iter >= iter_num || ceil_lb(best) >= limit ) {
+      break;
+    }
+
+    if ( !update_mult(matrix, mSubgrad, step_factor, target - val, mMult) ) {
+      break;
+    }
+  }
+
+  // 次の呼び出しは最良の乗数から始める．
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    mMult[row->pos()] = mBestMult[row->pos()];
+  }
+
+  mBestLb = best;
+  mValid = true;
+
+  if ( best <= 0.0 ) {
+    return 0;
+  }
+  return ceil_lb(best);
+}
+
+// @brief 自身の複製を作る．
+LbCalc*
+LbLag::clone() const
+{
+  LbLag* calc = new LbLag();
+  calc->set_iter_num(mIterNum, mInitIterNum);
+  return calc;
+}
+
+// @brief 直前の計算で得られた列の縮約コストを返す．
+// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+// @param[out] rc_array 各列の縮約コストを入れる配列
+bool
+LbLag::get_reduced_cost(double& lb,
+			vector<double>& rc_array) const
+{
+  if ( !mValid ) {
+    return false;
+  }
+  lb = mBestLb;
+  rc_array = mBestRcArray;
+  return true;
+}
+
+// @brief 1回の呼び出しでの反復回数を設定する．
+// @param[in] iter_num 反復回数
+// @param[in] init_iter_num 乗数を初期化した時の反復回数
+void
+LbLag::set_iter_num(int iter_num,
+		    int init_iter_num)
+{
+  mIterNum = iter_num;
+  mInitIterNum = init_iter_num;
+}
+
+// @brief 乗数を初期化する．
+// @param[in] matrix 対象の行列
+void
+LbLag::init_mult(const McMatrix& matrix)
+{
+  mMult.clear();
+  mMult.resize(matrix.row_size(), 0.0);
+  mBestMult.clear();
+  mBestMult.resize(matrix.row_size(), 0.0);
+  LbCS::row_weights(matrix, mMult);
+}
+
+// @brief 乗数に対する L(u) と縮約コストと劣勾配を求める．
+// @param[in] matrix 対象の行列
+// @param[in] mult 各行の乗数の配列
+// @param[out] rc_array 各列の縮約コストを入れる配列
+// @param[out] subgrad 各行の劣勾配を入れる配列
+// @return L(u) を返す．
+double
+LbLag::eval(const McMatrix& matrix,
+	    const vector<double>& mult,
+	    vector<double>& rc_array,
+	    vector<int>& subgrad)
+{
+  double val = 0.0;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    val += mult[row->pos()];
+  }
+
+  // 縮約コストが負の列を選ぶ．
+  for ( const McColHead* col = matrix.col_front();
+	!matrix.is_col_end(col); col = col->next() ) {
+    double rc = matrix.col_cost(col->pos());
+    for ( const McCell* cell = col->front();
+	  !col->is_end(cell); cell = cell->col_next() ) {
+      rc -= mult[cell->row_pos()];
+    }
+    rc_array[col->pos()] = rc;
+    if ( rc < 0.0 ) {
+      val += rc;
+    }
+  }
+
+  // 劣勾配は 1 - (その行を被覆する選ばれた列の数)
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    int g = 1;
+    for ( const McCell* cell = row->front();
+	  !row->is_end(cell); cell = cell->row_next() ) {
+      if ( rc_array[cell->col_pos()] < 0.0 ) {
+	-- g;
+      }
+    }
+    subgrad[row->pos()] = g;
+  }
+
+  return val;
+}
+
+// @brief 劣勾配法で乗数を更新する．
+// @param[in] matrix 対象の行列
+// @param[in] subgrad 各行の劣勾配の配列
+// @param[in] step_factor 歩幅の係数
+// @param[in] gap 目標値と L(u) の差
+// @param[inout] mult 各行の乗数の配列
+// @return 更新できない時は false を返す．
+bool
+LbLag::update_mult(const McMatrix& matrix,
+		   const vector<int>& subgrad,
+		   double step_factor,
+		   double gap,
+		   vector<double>& mult)
+{
+  double norm = 0.0;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    int g = subgrad[row->pos()];
+    norm += g * g;
+  }
+  if ( norm == 0.0 ) {
+    // 緩和問題の解が実行可能で相補性も満たしているので最適．
+    return false;
+  }
+  if ( gap <= 0.0 ) {
+    return false;
+  }
+
+  double step = step_factor * gap / norm;
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    int row_pos = row->pos();
+    double u = mult[row_pos] + step * subgrad[row_pos];
+    mult[row_pos] = u > 0.0 ? u : 0.0;
+  }
+  return true;
+}
+
+// @brief L(u) が改善しなかった回数に応じて歩幅の係数を小さくする．
+// @param[in] improved L(u) が改善した時 true にする．
+// @param[in] fail_limit 歩幅を半分にする改善しなかった回数
+// @param[inout] fail_count 続けて改善しなかった回数
+// @param[inout] step_factor 歩幅の係数
+void
+LbLag::update_step(bool improved,
+		   int fail_limit,
+		   int& fail_count,
+		   double& step_factor)
+{
+  if ( improved ) {
+    fail_count = 0;
+    return;
+  }
+  ++ fail_count;
+  if ( fail_count >= fail_limit ) {
+    step_factor *= 0.5;
+    fail_count = 0;
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
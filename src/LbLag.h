@@ -0,0 +1,187 @@
+﻿#ifndef LBLAG_H
+#define LBLAG_H
+
+/// @file LbLag.h
+/// @brief LbLag のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LbCalc.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class LbLag LbLag.h "LbLag.h"
+/// @brief ラグランジュ緩和を用いた下界の計算クラス
+///
+/// 各行の被覆制約に乗数 u を掛けて目的関数に移した緩和問題
+///   L(u) = Σ_i u_i + Σ_j min(0, c_j - Σ_{i ∈ j} u_i)
+/// は任意の u >= 0 で下界となるので，劣勾配法で u を更新して
+/// 大きな L(u) を探す．
+///
+/// 乗数は行番号ごとに保持しておき，次の呼び出しではそこから始める．
+/// 分枝限定法では直前に計算したノード(多くの場合は親ノード)の乗数が
+/// 良い初期値になるので，ノードごとの反復回数は少なくてよい．
+//////////////////////////////////////////////////////////////////////
+class LbLag :
+  public LbCalc
+{
+public:
+
+  /// @brief コンストラクタ
+  LbLag();
+
+  /// @brief デストラクタ
+  virtual
+  ~LbLag();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 下界の計算をする
+  virtual
+  int
+  operator()(const McMatrix& matrix);
+
+  /// @brief 打ち切りの値を指定して下界の計算をする．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] limit 打ち切りの値
+  ///
+  /// limit は劣勾配法の目標値としても用いる．
+  virtual
+  int
+  operator()(const McMatrix& matrix,
+	     int limit);
+
+  /// @brief 自身の複製を作る．
+  ///
+  /// 乗数は複製しない．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief 直前の計算で得られた列の縮約コストを返す．
+  /// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+  /// @param[out] rc_array 各列の縮約コストを入れる配列
+  /// @return 縮約コストが得られない時は false を返す．
+  ///
+  /// 最良の L(u) を与えた乗数での縮約コストを返す．
+  virtual
+  bool
+  get_reduced_cost(double& lb,
+		   vector<double>& rc_array) const;
+
+  /// @brief 1回の呼び出しでの反復回数を設定する．
+  /// @param[in] iter_num 反復回数
+  /// @param[in] init_iter_num 乗数を初期化した時の反復回数
+  void
+  set_iter_num(int iter_num,
+	       int init_iter_num);
+
+  /// @brief 乗数に対する L(u) と縮約コストと劣勾配を求める．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] mult 各行の乗数の配列
+  /// @param[out] rc_array 各列の縮約コストを入れる配列
+  /// @param[out] subgrad 各行の劣勾配を入れる配列
+  /// @return L(u) を返す．
+  ///
+  /// 緩和問題の解は縮約コストが負の列の集合で，劣勾配は
+  /// 1 - (その行を被覆する緩和問題の解の列の数) となる．
+  /// McSolver::lagrangian() でも用いる．
+  static
+  double
+  eval(const McMatrix& matrix,
+       const vector<double>& mult,
+       vector<double>& rc_array,
+       vector<int>& subgrad);
+
+  /// @brief 劣勾配法で乗数を更新する．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] subgrad 各行の劣勾配の配列
+  /// @param[in] step_factor 歩幅の係数
+  /// @param[in] gap 目標値と L(u) の差
+  /// @param[inout] mult 各行の乗数の配列
+  /// @return 更新できない時は false を返す．
+  ///
+  /// 劣勾配が 0 の時は緩和問題の解が最適なので，
+  /// gap が 0 以下の時は目標値に達しているので更新しない．
+  static
+  bool
+  update_mult(const McMatrix& matrix,
+	      const vector<int>& subgrad,
+	      double step_factor,
+	      double gap,
+	      vector<double>& mult);
+
+  /// @brief L(u) が改善しなかった回数に応じて歩幅の係数を小さくする．
+  /// @param[in] improved L(u) が改善した時 true にする．
+  /// @param[in] fail_limit 歩幅を半分にする改善しなかった回数
+  /// @param[inout] fail_count 続けて改善しなかった回数
+  /// @param[inout] step_factor 歩幅の係数
+  static
+  void
+  update_step(bool improved,
+	      int fail_limit,
+	      int& fail_count,
+	      double& step_factor);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 乗数を初期化する．
+  /// @param[in] matrix 対象の行列
+  ///
+  /// 各行の乗数を column splitting の値(その行を含む列の
+  /// コストを要素数で割った値の最小値)にする．
+  /// この時の L(u) は LbCS の値(の切り上げ前)に等しい．
+  void
+  init_mult(const McMatrix& matrix);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 1回の呼び出しでの反復回数
+  int mIterNum;
+
+  // 乗数を初期化した時の反復回数
+  int mInitIterNum;
+
+  // 各行の乗数の配列
+  vector<double> mMult;
+
+  // 最良の L(u) を与えた乗数の配列
+  vector<double> mBestMult;
+
+  // 各行の劣勾配の配列
+  vector<int> mSubgrad;
+
+  // 各列の縮約コストの配列
+  vector<double> mRcArray;
+
+  // 最良の L(u) を与えた乗数での各列の縮約コストの配列
+  vector<double> mBestRcArray;
+
+  // 直前の計算で得られた最良の L(u)
+  double mBestLb;
+
+  // mBestRcArray が有効な時 true となるフラグ
+  bool mValid;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // LBLAG_H
@@ -17,13 +17,21 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-LbMAX::LbMAX()
+LbMAX::LbMAX() :
+  mParallel(false),
+  mEvalNum(0),
+  mGeneration(0),
+  mRunNum(0),
+  mQuit(false),
+  mMatrix(nullptr),
+  mLimit(0)
 {
 }
 
 // @brief デストラクタ
 LbMAX::~LbMAX()
 {
+  stop_workers();
   for ( auto calc: mCalcList ) {
     delete calc;
   }
@@ -33,11 +41,66 @@ LbMAX::~LbMAX()
 int
 LbMAX::operator()(const McMatrix& matrix)
 {
-  int max_val = 0;
-  for ( auto calc_p: mCalcList ) {
-    int val = (*calc_p)(matrix);
+  return (*this)(matrix, INT_MAX);
+}
+
+// @brief 打ち切りの値を指定して下界の計算をする．
+// @param[in] matrix 対象の行列
+// @param[in] limit 打ち切りの値
+int
+LbMAX::operator()(const McMatrix& matrix,
+		  int limit)
+{
+  int n = mCalcList.size();
+  mEvalNum = 0;
+  if ( n == 0 ) {
+    return 0;
+  }
+
+  // 先頭(一番軽いもの)だけで打ち切れるならそれで終わる．
+  int max_val = (*mCalcList[0])(matrix, limit);
+  mEvalNum = 1;
+  if ( max_val >= limit || n == 1 ) {
+    return max_val;
+  }
+
+  if ( mParallel && n > 2 ) {
+    // 残りを別々のスレッドで計算する．
+    // 各 LbCalc は行列に書き込まないので同時に呼んでも問題ない．
+    if ( static_cast<int>(mWorkerList.size()) != n - 2 ) {
+      start_workers();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mMatrix = &matrix;
+      mLimit = limit;
+      mRunNum = n - 2;
+      ++ mGeneration;
+    }
+    mStartCond.notify_all();
+    int val = (*mCalcList[n - 1])(matrix, limit);
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mDoneCond.wait(lock, [this]() { return mRunNum == 0; });
+      mValArray[n - 1] = val;
+    }
+    mEvalNum = n;
+    for ( int i = 1; i < n; ++ i ) {
+      if ( max_val < mValArray[i] ) {
+	max_val = mValArray[i];
+      }
+    }
+    return max_val;
+  }
+
+  for ( int i = 1; i < n; ++ i ) {
+    int val = (*mCalcList[i])(matrix, limit);
+    mEvalNum = i + 1;
     if ( max_val < val ) {
       max_val = val;
+      if ( max_val >= limit ) {
+	break;
+      }
     }
   }
   return max_val;
@@ -50,5 +113,138 @@ LbMAX::add_calc(LbCalc* calc)
   mCalcList.push_back(calc);
 }
 
+// @brief 並列計算を行うかを設定する．
+// @param[in] flag 並列計算を行う時 true にする．
+void
+LbMAX::set_parallel(bool flag)
+{
+  mParallel = flag;
+  if ( !flag ) {
+    stop_workers();
+  }
+}
+
+// @brief ワーカスレッドを起動する．
+void
+LbMAX::start_workers()
+{
+  stop_workers();
+  int n = mCalcList.size();
+  mValArray.assign(n, 0);
+  mWorkerList.reserve(n - 2);
+  for ( int i = 1; i < n - 1; ++ i ) {
+    mWorkerList.push_back(std::thread(&LbMAX::worker, this, i, mGeneration));
+  }
+}
+
+// @brief ワーカスレッドを終了させる．
+void
+LbMAX::stop_workers()
+{
+  if ( mWorkerList.empty() ) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQuit = true;
+  }
+  mStartCond.notify_all();
+  for ( auto& th: mWorkerList ) {
+    th.join();
+  }
+  mWorkerList.clear();
+  mQuit = false;
+}
+
+// @brief ワーカスレッドの処理
+// @param[in] pos 受け持つ計算クラスの位置
+// @param[in] gen 起動時の世代番号
+void
+LbMAX::worker(int pos,
+	      int gen)
+{
+  for ( ; ; ) {
+    const McMatrix* matrix;
+    int limit;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStartCond.wait(lock, [this, gen]() { return mQuit || mGeneration != gen; });
+      if ( mQuit ) {
+	return;
+      }
+      gen = mGeneration;
+      matrix = mMatrix;
+      limit = mLimit;
+    }
+    int val = (*mCalcList[pos])(*matrix, limit);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mValArray[pos] = val;
+      -- mRunNum;
+      if ( mRunNum == 0 ) {
+	mDoneCond.notify_one();
+      }
+    }
+  }
+}
+
+// @brief 自身の複製を作る．
+LbCalc*
+LbMAX::clone() const
+{
+  LbMAX* calc = new LbMAX();
+  for ( auto calc_p: mCalcList ) {
+    calc->add_calc(calc_p->clone());
+  }
+  calc->set_parallel(mParallel);
+  return calc;
+}
+
+// @brief 行の衝突グラフを用いる時 true を返す．
+bool
+LbMAX::need_conflict_graph() const
+{
+  for ( auto calc_p: mCalcList ) {
+    if ( calc_p->need_conflict_graph() ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief column splitting の行の重みを用いる時 true を返す．
+bool
+LbMAX::need_row_weight() const
+{
+  for ( auto calc_p: mCalcList ) {
+    if ( calc_p->need_row_weight() ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 直前の計算で得られた列の縮約コストを返す．
+// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+// @param[out] rc_array 各列の縮約コストを入れる配列
+bool
+LbMAX::get_reduced_cost(double& lb,
+			vector<double>& rc_array) const
+{
+  bool found = false;
+  vector<double> tmp_array;
+  for ( int i = 0; i < mEvalNum; ++ i ) {
+    double lb1;
+    if ( mCalcList[i]->get_reduced_cost(lb1, tmp_array) ) {
+      if ( !found || lb < lb1 ) {
+	found = true;
+	lb = lb1;
+	rc_array.swap(tmp_array);
+      }
+    }
+  }
+  return found;
+}
+
 
 END_NAMESPACE_YM_MINCOV
@@ -10,6 +10,9 @@
 
 
 #include "LbCalc.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -17,6 +20,9 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class LbMAX LbMAX.h "LbMAX.h"
 /// @brief 複数の LbCalc の MAX を計算するクラス
+///
+/// 打ち切りの値が与えられた場合，いずれかの下界がその値に達した時点で
+/// 残りの計算を省略する．そのため軽いものから順に add_calc() すること．
 //////////////////////////////////////////////////////////////////////
 class LbMAX :
   public LbCalc
@@ -41,10 +47,81 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 打ち切りの値を指定して下界の計算をする．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] limit 打ち切りの値
+  virtual
+  int
+  operator()(const McMatrix& matrix,
+	     int limit);
+
+  /// @brief 自身の複製を作る．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief 行の衝突グラフを用いる時 true を返す．
+  ///
+  /// いずれかの計算クラスが用いる時 true を返す．
+  virtual
+  bool
+  need_conflict_graph() const;
+
+  /// @brief column splitting の行の重みを用いる時 true を返す．
+  ///
+  /// いずれかの計算クラスが用いる時 true を返す．
+  virtual
+  bool
+  need_row_weight() const;
+
+  /// @brief 直前の計算で得られた列の縮約コストを返す．
+  /// @param[out] lb 縮約コストに対応する下界(切り上げ前の値)
+  /// @param[out] rc_array 各列の縮約コストを入れる配列
+  /// @return 縮約コストが得られない時は false を返す．
+  ///
+  /// 直前の計算で実際に呼ばれた計算クラスのうち，
+  /// 縮約コストを持ち lb が最大のものの値を返す．
+  virtual
+  bool
+  get_reduced_cost(double& lb,
+		   vector<double>& rc_array) const;
+
   /// @brief 下界の計算クラスを追加する．
   void
   add_calc(LbCalc* calc);
 
+  /// @brief 並列計算を行うかを設定する．
+  /// @param[in] flag 並列計算を行う時 true にする．
+  ///
+  /// true の時，先頭の計算クラスで打ち切れなかったら
+  /// 残りの計算クラスを別々のスレッドで同時に計算する．
+  /// スレッドは最初の並列計算の時に作って使い回す．
+  void
+  set_parallel(bool flag);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ワーカスレッドを起動する．
+  ///
+  /// mCalcList の 1 番目から末尾の一つ前までを一つずつ受け持つ．
+  void
+  start_workers();
+
+  /// @brief ワーカスレッドを終了させる．
+  void
+  stop_workers();
+
+  /// @brief ワーカスレッドの処理
+  /// @param[in] pos 受け持つ計算クラスの位置
+  /// @param[in] gen 起動時の世代番号
+  void
+  worker(int pos,
+	 int gen);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -54,6 +131,44 @@ private:
   // 下界の計算クラスのリスト
   vector<LbCalc*> mCalcList;
 
+  // 並列計算を行う時 true にするフラグ
+  bool mParallel;
+
+  // 直前の計算で呼ばれた計算クラスの数
+  // 呼ばれるのは常に mCalcList の先頭からなのでその数だけ覚えておく．
+  int mEvalNum;
+
+  // ワーカスレッドのリスト
+  vector<std::thread> mWorkerList;
+
+  // 以下のワーカスレッドとの共有データを保護する mutex
+  std::mutex mMutex;
+
+  // ワーカスレッドに計算の開始を知らせる条件変数
+  std::condition_variable mStartCond;
+
+  // ワーカスレッドの計算の終了を知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 計算の世代番号
+  // 計算を始めるごとに一つ増やす．
+  int mGeneration;
+
+  // 計算の終わっていないワーカスレッドの数
+  int mRunNum;
+
+  // ワーカスレッドを終了させる時 true にするフラグ
+  bool mQuit;
+
+  // 計算の対象の行列
+  const McMatrix* mMatrix;
+
+  // 打ち切りの値
+  int mLimit;
+
+  // 各計算クラスの値の配列
+  vector<int> mValArray;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -9,49 +9,25 @@
 
 #include "LbMIS1.h"
 #include "McMatrix.h"
-#include "ym/SimpleAlloc.h"
+#include "McConflictGraph.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
-struct Node {
-
-  void
-  set(int pos);
-
-  int mRowPos;
-  bool mDeleted;
-  Node** mAdjLink;
-  int mAdjNum;
-  int mNum;
-  Node* mNext;
-
-  int mHeapIdx;
-};
+//////////////////////////////////////////////////////////////////////
+// クラス LbMIS1
+//////////////////////////////////////////////////////////////////////
 
-void
-Node::set(int pos)
+// @brief コンストラクタ
+LbMIS1::LbMIS1() :
+  mLsIterNum(0)
 {
-  mRowPos = pos;
-  mDeleted = false;
-  mNum = 0;
-  mNext = nullptr;
 }
 
-struct Lt
+// @brief デストラクタ
+LbMIS1::~LbMIS1()
 {
-  bool
-  operator()(Node* left,
-	     Node* right)
-  {
-    return left->mNum < right->mNum;
-  }
-};
-
-
-//////////////////////////////////////////////////////////////////////
-// クラス LbMIS1
-//////////////////////////////////////////////////////////////////////
+}
 
 // @brief 下限を求める．
 // @param[in] matrix 対象の行列
@@ -63,143 +39,265 @@ LbMIS1::operator()(const McMatrix& matrix)
     return 0;
   }
 
+  // 行列が衝突グラフを持っていなければここで作る．
+  const McConflictGraph* graph = matrix.conflict_graph();
+  if ( graph == nullptr ) {
+    McConflictGraph tmp_graph(matrix);
+    return calc(matrix, tmp_graph);
+  }
+  return calc(matrix, *graph);
+}
+
+// @brief 衝突グラフを用いて下界を計算する．
+// @param[in] matrix 対象の行列
+// @param[in] graph matrix の行の衝突グラフ
+int
+LbMIS1::calc(const McMatrix& matrix,
+	     const McConflictGraph& graph)
+{
   // MIS を用いた下限
 
-  // 各行に対応する Node というオブジェクトを作る．
-  // ndoe_array[row_pos] に row_pos の行の Node が入る．
-  // top から Node::mNext を使ってリンクトリストを作る．
-  SimpleAlloc alloc;
+  // 各行を隣接する行の数を値としてキューに入れる．
   int rs = matrix.row_size();
-  int rn = matrix.row_num();
-  void* p = alloc.get_memory(sizeof(Node*) * rs);
-  Node** node_array = new (p) Node*[rs];
-  for ( int i = 0; i < rs; ++ i ) {
-    node_array[i] = nullptr;
+  int max_num = 0;
+  for ( const McRowHead* row1 = matrix.row_front();
+	!matrix.is_row_end(row1); row1 = row1->next() ) {
+    max_num = std::max(max_num, graph.adj_num(row1->pos()));
   }
-  void* q = alloc.get_memory(sizeof(Node) * rn);
-  Node* node_chunk = new (q) Node[rn];
-  Node* top = nullptr;
-  Node* last = nullptr;
-  int idx = 0;
+  mQueue.init(rs, max_num);
+  mNum.resize(rs);
+  mTouched.assign(rs, 0);
+  // 分岐なしで書き込むので一つ余分に確保しておく．
+  mTouchList.resize(rs + 1);
   for ( const McRowHead* row1 = matrix.row_front();
 	!matrix.is_row_end(row1); row1 = row1->next() ) {
     int row_pos = row1->pos();
-    Node* node = &node_chunk[idx];
-    ++ idx;
-    node->set(row_pos);
-    node_array[row_pos] = node;
-    if ( last == nullptr ) {
-      ASSERT_COND( top == nullptr );
-      top = node;
+    int num = graph.adj_num(row_pos);
+    mNum[row_pos] = num;
+    mQueue.put(row_pos, num);
+  }
+
+  // 未処理の行のうち隣接する未処理の行の数が最小のものを取り出し，解に加える．
+  // 実際にはその行を被覆する列の最小コストを解に足す．
+  int cost = 0;
+  mSelList.clear();
+  while ( !mQueue.empty() ) {
+    int row_pos1 = mQueue.get_min();
+    mSelList.push_back(row_pos1);
+
+    // row_pos1 の行を被覆する列の最小コストを求める．
+    int min_cost = INT_MAX;
+    const McRowHead* row = matrix.row(row_pos1);
+    for ( const McCell* cell = row->front();
+	  !row->is_end(cell); cell = cell->row_next() ) {
+      int cpos = cell->col_pos();
+      if ( min_cost > matrix.col_cost(cpos) ) {
+	min_cost = matrix.col_cost(cpos);
+      }
     }
-    else {
-      last->mNext = node;
+    cost += min_cost;
+
+    // row_pos1 に隣接している行も処理済みとする．
+    // 先に全てキューから取り除いておけば，それらの値を減らす必要はない．
+    mRowList.clear();
+    int n1 = graph.adj_num(row_pos1);
+    for ( int i = 0; i < n1; ++ i ) {
+      int row_pos2 = graph.adj_row(row_pos1, i);
+      if ( mQueue.in_queue(row_pos2) ) {
+	mQueue.erase(row_pos2);
+	mRowList.push_back(row_pos2);
+      }
+    }
+
+    // さらにそれらに隣接している行の値を減らす．
+    // 密なグラフではこのループが最も重いので，ここでは処理済みかどうかに
+    // 関わらず mNum を減らして触った行を重複なく記録するだけにしておき，
+    // キューの更新は触った行ごとに一度だけ行う．
+    int touch_num = 0;
+    for ( auto row_pos2: mRowList ) {
+      int n2 = graph.adj_num(row_pos2);
+      for ( int j = 0; j < n2; ++ j ) {
+	int row_pos3 = graph.adj_row(row_pos2, j);
+	-- mNum[row_pos3];
+	mTouchList[touch_num] = row_pos3;
+	touch_num += 1 - mTouched[row_pos3];
+	mTouched[row_pos3] = 1;
+      }
+    }
+    for ( int i = 0; i < touch_num; ++ i ) {
+      int row_pos3 = mTouchList[i];
+      mTouched[row_pos3] = 0;
+      if ( mQueue.in_queue(row_pos3) ) {
+	mQueue.dec_key(row_pos3, mQueue.key(row_pos3) - mNum[row_pos3]);
+      }
     }
-    last = node;
   }
 
-  // 同じ列を共有する行の関係を Node::mAdjLink で表す．
-  // node1 と列を共有する行の Node が node1->mAdjLink[0:node1->mAdjNum -1]
-  // に入る．
-  // node1->mNum も node1->mAdjNum で初期化される．
-  int* row_list = alloc.get_array<int>(rn);
+  if ( mLsIterNum > 0 ) {
+    cost += local_search(matrix, graph);
+  }
+
+  return cost;
+}
+
+// @brief 局所探索で独立集合を改善する．
+// @param[in] matrix 対象の行列
+// @param[in] graph matrix の行の衝突グラフ
+// @return 増えた重みを返す．
+int
+LbMIS1::local_search(const McMatrix& matrix,
+		     const McConflictGraph& graph)
+{
+  int rs = matrix.row_size();
+  mWeight.resize(rs);
   for ( const McRowHead* row1 = matrix.row_front();
 	!matrix.is_row_end(row1); row1 = row1->next() ) {
-    // マークを消す．
-    // 結構めんどくさいけど効率はいい
-    for (const McCell* cell1 = row1->front();
-	 !row1->is_end(cell1); cell1 = cell1->row_next()) {
-      const McColHead* col1 = matrix.col(cell1->col_pos());
-      for ( const McCell* cell2 = col1->front();
-	    !col1->is_end(cell2); cell2 = cell2->col_next() ) {
-	int row_pos = cell2->row_pos();
-	matrix.row(row_pos)->mWork = 0;
+    int min_cost = INT_MAX;
+    for ( const McCell* cell = row1->front();
+	  !row1->is_end(cell); cell = cell->row_next() ) {
+      int cpos = cell->col_pos();
+      if ( min_cost > matrix.col_cost(cpos) ) {
+	min_cost = matrix.col_cost(cpos);
       }
     }
-    // マークを用いて隣接関係を作る．
-    int row_pos1 = row1->pos();
-    int row_list_idx = 0;
-    for ( const McCell* cell1 = row1->front();
-	  !row1->is_end(cell1); cell1 = cell1->row_next() ) {
-      const McColHead* col1 = matrix.col(cell1->col_pos());
-      for ( const McCell* cell2 = col1->front();
-	    !col1->is_end(cell2); cell2 = cell2->col_next() ) {
-	int row_pos2 = cell2->row_pos();
-	if ( matrix.row(row_pos2)->mWork == 0 ) {
-	  matrix.row(row_pos2)->mWork = 1;
-	  row_list[row_list_idx] = row_pos2;
-	  ++ row_list_idx;
-	}
+    mWeight[row1->pos()] = min_cost;
+  }
+  mSelected.assign(rs, false);
+  mTight.assign(rs, 0);
+  mAdjMark.resize(rs);
+  mLsQueue.clear();
+  for ( auto row_pos: mSelList ) {
+    ls_insert(graph, row_pos);
+    mLsQueue.push_back(row_pos);
+  }
+
+  // 解の行を一つずつ取り出して (1,2)-swap か (1,1)-swap を試す．
+  // 入れ替えで加えた行はキューの末尾に積んで後で調べる．
+  int delta = 0;
+  int iter = 0;
+  for ( int rpos = 0;
+	rpos < static_cast<int>(mLsQueue.size()) && iter < mLsIterNum; ++ rpos ) {
+    int row_pos1 = mLsQueue[rpos];
+    if ( !mSelected[row_pos1] ) {
+      continue;
+    }
+    ++ iter;
+
+    // row_pos1 の隣接行は解に含まれないので，
+    // 解の行と隣接するのが row_pos1 だけのものが候補となる．
+    mCandList.clear();
+    int n1 = graph.adj_num(row_pos1);
+    for ( int i = 0; i < n1; ++ i ) {
+      int row_pos2 = graph.adj_row(row_pos1, i);
+      if ( mTight[row_pos2] == 1 ) {
+	mCandList.push_back(row_pos2);
       }
     }
-    Node* node1 = node_array[row_pos1];
-    void* p = alloc.get_memory(sizeof(Node*) * row_list_idx);
-    node1->mAdjLink = new (p) Node*[row_list_idx];
-    for ( int i = 0; i < row_list_idx; ++ i ) {
-      Node* node2 = node_array[row_list[i]];
-      node1->mAdjLink[i] = node2;
+    int nc = mCandList.size();
+    if ( nc == 0 ) {
+      continue;
     }
-    node1->mAdjNum = row_list_idx;
-    node1->mNum = row_list_idx;
-  }
 
-  // 未処理の Node のうち Node::mNum が最小のものを取り出し，解に加える．
-  // 実際にはその行を被覆する列の最小コストを解に足す．
-  int cost = 0;
-  for ( ; ; ) {
-    Node** pprev = &top;
-    Node* best_node = nullptr;
-    int best_num = UINT_MAX;
-    for ( ; ; ) {
-      Node* node = *pprev;
-      if ( node == nullptr ) {
-	break;
-      }
-      if ( node->mDeleted ) {
-	*pprev = node->mNext;
+    // 互いに隣接せず，重みの和が row_pos1 の重みを越える組を探す．
+    // 見つからなければ row_pos1 より重い候補一つと入れ替える．
+    int w1 = mWeight[row_pos1];
+    int u = -1;
+    int v = -1;
+    for ( int i = 0; i < nc - 1 && u == -1; ++ i ) {
+      int row_pos2 = mCandList[i];
+      mAdjMark.clear();
+      int n2 = graph.adj_num(row_pos2);
+      for ( int k = 0; k < n2; ++ k ) {
+	mAdjMark.set(graph.adj_row(row_pos2, k));
       }
-      else {
-	int num = node->mNum;
-	if ( best_num > num ) {
-	  best_num = num;
-	  best_node = node;
+      for ( int j = i + 1; j < nc; ++ j ) {
+	int row_pos3 = mCandList[j];
+	if ( !mAdjMark.check(row_pos3) &&
+	     mWeight[row_pos2] + mWeight[row_pos3] > w1 ) {
+	  u = row_pos2;
+	  v = row_pos3;
+	  break;
 	}
-	pprev = &node->mNext;
       }
     }
-    if ( best_node == nullptr ) {
-      break;
+    if ( u == -1 ) {
+      for ( auto row_pos2: mCandList ) {
+	if ( mWeight[row_pos2] > w1 &&
+	     ( u == -1 || mWeight[row_pos2] > mWeight[u] ) ) {
+	  u = row_pos2;
+	}
+      }
+      if ( u == -1 ) {
+	continue;
+      }
     }
 
-    // best_node に対応する行を被覆する列の最小コストを求める．
-    int min_cost = UINT_MAX;
-    const McRowHead* row = matrix.row(best_node->mRowPos);
-    for ( const McCell* cell = row->front();
-	  !row->is_end(cell); cell = cell->row_next() ) {
-      int cpos = cell->col_pos();
-      if ( min_cost > matrix.col_cost(cpos) ) {
-	min_cost = matrix.col_cost(cpos);
-      }
+    // row_pos1 を外して u, v を加える．
+    mSelected[row_pos1] = false;
+    for ( int i = 0; i < n1; ++ i ) {
+      -- mTight[graph.adj_row(row_pos1, i)];
+    }
+    delta -= w1;
+    ls_insert(graph, u);
+    delta += mWeight[u];
+    mLsQueue.push_back(u);
+    if ( v != -1 ) {
+      ls_insert(graph, v);
+      delta += mWeight[v];
+      mLsQueue.push_back(v);
     }
-    cost += min_cost;
 
-    // 処理済みの印をつける．
-    best_node->mDeleted = true;
-    for (ymuint i = 0; i < best_node->mAdjNum; ++ i) {
-      // best_node に隣接しているノードも処理済みとする．
-      Node* node2 = best_node->mAdjLink[i];
-      if ( !node2->mDeleted ) {
-	node2->mDeleted = true;
-	// さらにこのノードに隣接しているノードの mNum を減らす．
-	for (ymuint j = 0; j < node2->mAdjNum; ++ j) {
-	  Node* node3 = node2->mAdjLink[j];
-	  -- node3->mNum;
-	}
+    // 他に解の行と隣接しなくなった行があれば加える．
+    for ( int i = 0; i < n1; ++ i ) {
+      int row_pos2 = graph.adj_row(row_pos1, i);
+      if ( !mSelected[row_pos2] && mTight[row_pos2] == 0 ) {
+	ls_insert(graph, row_pos2);
+	delta += mWeight[row_pos2];
+	mLsQueue.push_back(row_pos2);
       }
     }
   }
 
-  return cost;
+  return delta;
+}
+
+// @brief 行を独立集合に加える．
+// @param[in] graph 衝突グラフ
+// @param[in] row_pos 行番号
+void
+LbMIS1::ls_insert(const McConflictGraph& graph,
+		  int row_pos)
+{
+  ASSERT_COND( !mSelected[row_pos] && mTight[row_pos] == 0 );
+  mSelected[row_pos] = true;
+  int n = graph.adj_num(row_pos);
+  for ( int i = 0; i < n; ++ i ) {
+    ++ mTight[graph.adj_row(row_pos, i)];
+  }
+}
+
+// @brief 自身の複製を作る．
+LbCalc*
+LbMIS1::clone() const
+{
+  LbMIS1* calc = new LbMIS1();
+  calc->set_ls_iter_num(mLsIterNum);
+  return calc;
+}
+
+// @brief 行の衝突グラフを用いる時 true を返す．
+bool
+LbMIS1::need_conflict_graph() const
+{
+  return true;
+}
+
+// @brief 局所探索の反復回数を設定する．
+// @param[in] iter_num 反復回数
+void
+LbMIS1::set_ls_iter_num(int iter_num)
+{
+  mLsIterNum = iter_num;
 }
 
 END_NAMESPACE_YM_MINCOV
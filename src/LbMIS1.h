@@ -10,6 +10,8 @@
 
 
 #include "LbCalc.h"
+#include "MisBucketQueue.h"
+#include "McMark.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -18,11 +20,27 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// @class LbMIS1 LbMIS1.h "LbMIS1.h"
 /// @brief MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// ノードをリンクトリストでつなぐ実装
+/// 隣接する行の数をキーとするバケットキューで最小の行を取り出す．
+///
+/// set_ls_iter_num() で反復回数を指定すると，貪欲法で求めた独立集合を
+/// (1,2)-swap の局所探索(Andrade, Resende, Werneck)で改善する．
+/// 解の行 x を外して，x 以外に解の行と隣接しない x の隣接行のうち
+/// 互いに隣接しない2つ u, v を加える操作を重みの和が増える限り繰り返す．
+/// そのような組がない時は x より重い隣接行一つと入れ替える((1,1)-swap)．
 //////////////////////////////////////////////////////////////////////
 class LbMIS1 :
   public LbCalc
 {
+public:
+
+  /// @brief コンストラクタ
+  LbMIS1();
+
+  /// @brief デストラクタ
+  virtual
+  ~LbMIS1();
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // 外部インターフェイス
@@ -33,8 +51,120 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 自身の複製を作る．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief 行の衝突グラフを用いる時 true を返す．
+  virtual
+  bool
+  need_conflict_graph() const;
+
+  /// @brief 局所探索の反復回数を設定する．
+  /// @param[in] iter_num 反復回数
+  ///
+  /// 0 の時は局所探索を行わない．
+  void
+  set_ls_iter_num(int iter_num);
+
+  /// @brief 局所探索の反復回数を返す．
+  int
+  ls_iter_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 衝突グラフを用いて下界を計算する．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] graph matrix の行の衝突グラフ
+  int
+  calc(const McMatrix& matrix,
+       const McConflictGraph& graph);
+
+  /// @brief 局所探索で独立集合を改善する．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] graph matrix の行の衝突グラフ
+  /// @return 増えた重みを返す．
+  ///
+  /// 貪欲法で選んだ行は mSelList に入っている．
+  int
+  local_search(const McMatrix& matrix,
+	       const McConflictGraph& graph);
+
+  /// @brief 行を独立集合に加える．
+  /// @param[in] graph 衝突グラフ
+  /// @param[in] row_pos 行番号
+  void
+  ls_insert(const McConflictGraph& graph,
+	    int row_pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 未処理の行のキュー
+  MisBucketQueue mQueue;
+
+  // 処理済みにした行を一時的に入れておくリスト
+  vector<int> mRowList;
+
+  // 各行に隣接する未処理の行の数の配列
+  // 処理済みの行の値は意味を持たない．
+  vector<int> mNum;
+
+  // mTouchList に入っている行の印
+  vector<int> mTouched;
+
+  // 値の変わった行を一時的に入れておくリスト
+  vector<int> mTouchList;
+
+  // 局所探索の反復回数
+  int mLsIterNum;
+
+  // 貪欲法で選んだ行のリスト
+  vector<int> mSelList;
+
+  // 以下は局所探索で用いる．
+
+  // 各行の重み(被覆する列の最小コスト)の配列
+  vector<int> mWeight;
+
+  // 独立集合に含まれる行の時 true となる配列
+  vector<bool> mSelected;
+
+  // 各行に隣接する独立集合の行の数の配列
+  vector<int> mTight;
+
+  // 調べる行のキュー
+  vector<int> mLsQueue;
+
+  // 入れ替えの候補の行のリスト
+  vector<int> mCandList;
+
+  // 隣接関係を調べるための行のマーク
+  McMark mAdjMark;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 局所探索の反復回数を返す．
+inline
+int
+LbMIS1::ls_iter_num() const
+{
+  return mLsIterNum;
+}
+
 END_NAMESPACE_YM_MINCOV
 
 #endif // LBMIS_H
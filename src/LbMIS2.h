@@ -9,7 +9,7 @@
 /// All rights reserved.
 
 
-#include "LbCalc.h"
+#include "LbMIS1.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -18,20 +18,22 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// @class LbMIS2 LbMIS2.h "LbMIS2.h"
 /// @brief MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// ヒープを使って最小要素を取り出す．
+/// もとはヒープを使って最小要素を取り出す実装だったが，
+/// 現在は LbMIS1 と同じバケットキューを用いる．
+/// 既存の設定との互換性のために残してある．
 //////////////////////////////////////////////////////////////////////
 class LbMIS2 :
-  public LbCalc
+  public LbMIS1
 {
 public:
   //////////////////////////////////////////////////////////////////////
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 下界の計算をする
+  /// @brief 自身の複製を作る．
   virtual
-  int
-  operator()(const McMatrix& matrix);
+  LbCalc*
+  clone() const;
 
 };
 
@@ -9,91 +9,83 @@
 
 #include "LbMIS3.h"
 #include "McMatrix.h"
-#include "ym/UdGraph.h"
-#include "ym/SimpleAlloc.h"
+#include "McConflictGraph.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
+BEGIN_NONAMESPACE
+
+// MaxClique を用いる行数の上限
+// ビットベクタの大きさは行数の2乗に比例するので，
+// これより多い時は貪欲法の結果だけを用いる．
+const int MAX_BIT_NUM = 4096;
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス LbMIS3
 //////////////////////////////////////////////////////////////////////
 
+// @brief コンストラクタ
+LbMIS3::LbMIS3() :
+  mNodeLimit(1000),
+  mClique(0)
+{
+}
+
+// @brief デストラクタ
+LbMIS3::~LbMIS3()
+{
+}
+
 // @brief 下限を求める．
 // @param[in] matrix 対象の行列
 // @return 下限値
 int
 LbMIS3::operator()(const McMatrix& matrix)
+{
+  return (*this)(matrix, INT_MAX);
+}
+
+// @brief 打ち切りの値を指定して下界の計算をする．
+// @param[in] matrix 対象の行列
+// @param[in] limit 打ち切りの値
+int
+LbMIS3::operator()(const McMatrix& matrix,
+		   int limit)
 {
   if ( matrix.row_num() == 0 ) {
     return 0;
   }
 
-  // MIS を用いた下限
-  // 各行に対応する Node というオブジェクトを作る．
-  // ndoe_array[row_pos] に row_pos の行の Node が入る．
-  // top から Node::mNext を使ってリンクとリストを作る．
-  SimpleAlloc alloc;
-  int rs = matrix.row_size();
-  int rn = matrix.row_num();
-
-  UdGraph graph(rs);
-
-  int* row_map = alloc.get_array<int>(rs);
-  for ( int i = 0; i < rs; ++ i ) {
-    row_map[i] = 0;
-  }
-
-  int idx = 0;
-  for ( const McRowHead* row1 = matrix.row_front();
-	!matrix.is_row_end(row1); row1 = row1->next() ) {
-    int row_pos = row1->pos();
-    row_map[row_pos] = idx;
-    ++ idx;
-  }
-
-  // 同じ列を共有する行の関係を Node::mAdjLink で表す．
-  // node1 と列を共有する行の Node が node1->mAdjLink[0:node1->mAdjNum -1]
-  // に入る．
-  // node1->mNum も node1->mAdjNum で初期化される．
-  for ( const McRowHead* row1 = matrix.row_front();
-	!matrix.is_row_end(row1); row1 = row1->next() ) {
-    // マークを消す．
-    // 結構めんどくさいけど効率はいい
-    for ( const McCell* cell1 = row1->front();
-	  !row1->is_end(cell1); cell1 = cell1->row_next() ) {
-      const McColHead* col1 = matrix.col(cell1->col_pos());
-      for ( const McCell* cell2 = col1->front();
-	    !col1->is_end(cell2); cell2 = cell2->col_next() ) {
-	int row_pos = cell2->row_pos();
-	matrix.row(row_pos)->mWork = 0;
-      }
-    }
-    // マークを用いて隣接関係を作る．
-    int row_pos1 = row1->pos();
-    int id1 = row_map[row_pos1];
-    int row_list_idx = 0;
-    for ( const McCell* cell1 = row1->front();
-	  !row1->is_end(cell1); cell1 = cell1->row_next() ) {
-      const McColHead* col1 = matrix.col(cell1->col_pos());
-      for ( const McCell* cell2 = col1->front();
-	    !col1->is_end(cell2); cell2 = cell2->col_next() ) {
-	int row_pos2 = cell2->row_pos();
-	if ( matrix.row(row_pos2)->mWork == 0 ) {
-	  matrix.row(row_pos2)->mWork = 1;
-	  int id2 = row_map[row_pos2];
-	  graph.connect(id1, id2);
-	}
-      }
-    }
+  // 行列が衝突グラフを持っていなければここで作る．
+  const McConflictGraph* graph = matrix.conflict_graph();
+  if ( graph == nullptr ) {
+    McConflictGraph tmp_graph(matrix);
+    return calc(matrix, tmp_graph, limit);
   }
+  return calc(matrix, *graph, limit);
+}
 
-  // 各行を被覆する列の最小コストを求める．
+// @brief 衝突グラフを用いて下界を計算する．
+// @param[in] matrix 対象の行列
+// @param[in] graph matrix の行の衝突グラフ
+// @param[in] limit 打ち切りの値
+int
+LbMIS3::calc(const McMatrix& matrix,
+	     const McConflictGraph& graph,
+	     int limit)
+{
+  // 各行を被覆する列の最小コストを重みとする．
+  int rs = matrix.row_size();
+  mWeight.resize(rs);
+  mRowList.clear();
   for ( const McRowHead* row1 = matrix.row_front();
 	!matrix.is_row_end(row1); row1 = row1->next() ) {
     int row_pos = row1->pos();
-    int id = row_map[row_pos];
-    int min_cost = UINT_MAX;
+    int min_cost = INT_MAX;
     for ( const McCell* cell = row1->front();
 	  !row1->is_end(cell); cell = cell->row_next() ) {
       int cpos = cell->col_pos();
@@ -101,14 +93,96 @@ LbMIS3::operator()(const McMatrix& matrix)
 	min_cost = matrix.col_cost(cpos);
       }
     }
+    mWeight[row_pos] = min_cost;
+    mRowList.push_back(row_pos);
+  }
+
+  int n = mRowList.size();
+  if ( n > MAX_BIT_NUM ) {
+    return greedy(matrix, graph);
+  }
+
+  // 衝突グラフの補グラフを作る．
+  mRowMap.resize(rs);
+  mClique.init(n);
+  for ( int id = 0; id < n; ++ id ) {
+    int row_pos = mRowList[id];
+    mRowMap[row_pos] = id;
+    mClique.set_cost(id, mWeight[row_pos]);
+  }
+  for ( int id1 = 0; id1 < n; ++ id1 ) {
+    int row_pos1 = mRowList[id1];
+    int n1 = graph.adj_num(row_pos1);
+    for ( int i = 0; i < n1; ++ i ) {
+      int id2 = mRowMap[graph.adj_row(row_pos1, i)];
+      if ( id2 > id1 ) {
+	mClique.connect(id1, id2);
+      }
+    }
+  }
+  mClique.complement();
+
+  mClique.set_node_limit(mNodeLimit);
+  // 重みは整数なので和も double で正確に表せる．
+  double cost = mClique.solve(mAns, limit);
+  return static_cast<int>(cost);
+}
+
+// @brief 貪欲法で独立集合を求める．
+// @param[in] matrix 対象の行列
+// @param[in] graph matrix の行の衝突グラフ
+// @return 独立集合の重みを返す．
+int
+LbMIS3::greedy(const McMatrix& matrix,
+	       const McConflictGraph& graph)
+{
+  sort(mRowList.begin(), mRowList.end(),
+       [&](int a, int b) {
+	 // w_a / (n_a + 1) > w_b / (n_b + 1) を整数で比較する．
+	 ymint64 va = static_cast<ymint64>(mWeight[a]) * (graph.adj_num(b) + 1);
+	 ymint64 vb = static_cast<ymint64>(mWeight[b]) * (graph.adj_num(a) + 1);
+	 return va > vb;
+       });
+
+  // mRowMark は選べなくなった行の印
+  mRowMark.resize(matrix.row_size());
+  mRowMark.clear();
+  int weight = 0;
+  for ( auto row_pos1: mRowList ) {
+    if ( mRowMark.check(row_pos1) ) {
+      continue;
+    }
+    weight += mWeight[row_pos1];
+    int n = graph.adj_num(row_pos1);
+    for ( int i = 0; i < n; ++ i ) {
+      mRowMark.set(graph.adj_row(row_pos1, i));
+    }
   }
+  return weight;
+}
 
-  vector<int> node_set;
-  max_clique(graph, node_set);
-#warning "TODO: 未完成"
-  int cost = 0;
+// @brief 自身の複製を作る．
+LbCalc*
+LbMIS3::clone() const
+{
+  LbMIS3* calc = new LbMIS3();
+  calc->set_node_limit(mNodeLimit);
+  return calc;
+}
 
-  return cost;
+// @brief 行の衝突グラフを用いる時 true を返す．
+bool
+LbMIS3::need_conflict_graph() const
+{
+  return true;
+}
+
+// @brief 1回の呼び出しでの探索ノード数の上限を設定する．
+// @param[in] node_limit 探索ノード数の上限
+void
+LbMIS3::set_node_limit(int node_limit)
+{
+  mNodeLimit = node_limit;
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -10,19 +10,38 @@
 
 
 #include "LbCalc.h"
+#include "McMark.h"
+#include "MaxClique.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
 //////////////////////////////////////////////////////////////////////
 /// @class LbMIS3 LbMIS3.h "LbMIS3.h"
-/// @brief MIS(maximum independent set) を用いた下界の計算クラス
+/// @brief 重み付き MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// get_mis() 関数を使う
+/// 列を共有しない(衝突グラフ上で独立な)行の集合はそれぞれ別の列で
+/// 被覆しなければならないので，各行を被覆する列の最小コストを重みとした
+/// 独立集合の重みの和は下界となる．
+///
+/// 衝突グラフの補グラフの重み付き最大クリークを MaxClique で求める．
+/// 探索ノード数が上限に達したらそこで打ち切るが，それまでに見つかった
+/// 最良のクリーク(独立集合)の重みも下界として正しい．
+/// 行数が多くてビットベクタが大きくなりすぎる時は貪欲法の結果だけを用いる．
 //////////////////////////////////////////////////////////////////////
 class LbMIS3 :
   public LbCalc
 {
+public:
+
+  /// @brief コンストラクタ
+  LbMIS3();
+
+  /// @brief デストラクタ
+  virtual
+  ~LbMIS3();
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // 外部インターフェイス
@@ -33,6 +52,85 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 打ち切りの値を指定して下界の計算をする．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] limit 打ち切りの値
+  ///
+  /// limit 以上の独立集合が見つかった時点で探索を打ち切る．
+  virtual
+  int
+  operator()(const McMatrix& matrix,
+	     int limit);
+
+  /// @brief 自身の複製を作る．
+  virtual
+  LbCalc*
+  clone() const;
+
+  /// @brief 行の衝突グラフを用いる時 true を返す．
+  virtual
+  bool
+  need_conflict_graph() const;
+
+  /// @brief 1回の呼び出しでの探索ノード数の上限を設定する．
+  /// @param[in] node_limit 探索ノード数の上限
+  ///
+  /// 0 の時は貪欲法で求めた独立集合だけを用いる．
+  void
+  set_node_limit(int node_limit);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 衝突グラフを用いて下界を計算する．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] graph matrix の行の衝突グラフ
+  /// @param[in] limit 打ち切りの値
+  int
+  calc(const McMatrix& matrix,
+       const McConflictGraph& graph,
+       int limit);
+
+  /// @brief 貪欲法で独立集合を求める．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] graph matrix の行の衝突グラフ
+  /// @return 独立集合の重みを返す．
+  ///
+  /// 重み / (隣接する行の数 + 1) の大きい順に選べる行を選ぶ．
+  int
+  greedy(const McMatrix& matrix,
+	 const McConflictGraph& graph);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 1回の呼び出しでの探索ノード数の上限
+  int mNodeLimit;
+
+  // 各行の重みの配列
+  vector<int> mWeight;
+
+  // 通し番号から行番号への変換表
+  vector<int> mRowList;
+
+  // 行番号から通し番号への変換表
+  vector<int> mRowMap;
+
+  // 重み付き最大クリークを求めるオブジェクト
+  MaxClique mClique;
+
+  // 解を入れる配列
+  vector<int> mAns;
+
+  // 貪欲法で用いる行の印
+  McMark mRowMark;
+
 };
 
 END_NAMESPACE_YM_MINCOV
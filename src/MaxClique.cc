@@ -12,6 +12,14 @@
 
 BEGIN_NAMESPACE_YM_MINCOV
 
+BEGIN_NONAMESPACE
+
+// 1ワードのビット数
+const int WORD_BITS = 64;
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス MaxClique
 //////////////////////////////////////////////////////////////////////
@@ -19,9 +27,10 @@ BEGIN_NAMESPACE_YM_MINCOV
 // @brief コンストラクタ
 // @param[in] size ノード数
 MaxClique::MaxClique(int size) :
-  mCostArray(size),
-  mNlistArray(size)
+  mNodeLimit(INT_MAX),
+  mOptimal(false)
 {
+  init(size);
 }
 
 // @brief デストラクタ
@@ -29,7 +38,21 @@ MaxClique::~MaxClique()
 {
 }
 
+// @brief 初期化する．
+// @param[in] size ノード数
+void
+MaxClique::init(int size)
+{
+  mSize = size;
+  mWordNum = (size + WORD_BITS - 1) / WORD_BITS;
+  mCostArray.assign(size, 1.0);
+  mAdjArray.assign(size * mWordNum, 0ULL);
+  mOptimal = false;
+}
+
 // @brief コストを設定する．
+// @param[in] id ノード番号 ( 0 <= id < size() )
+// @param[in] cost コスト ( cost >= 0.0 )
 void
 MaxClique::set_cost(int id,
 		    double cost)
@@ -43,114 +66,280 @@ void
 MaxClique::connect(int id1,
 		   int id2)
 {
-  mNlistArray[id1].push_back(id2);
-  mNlistArray[id2].push_back(id1);
+  if ( id1 == id2 ) {
+    return;
+  }
+  mAdjArray[id1 * mWordNum + id2 / WORD_BITS] |= 1ULL << (id2 % WORD_BITS);
+  mAdjArray[id2 * mWordNum + id1 / WORD_BITS] |= 1ULL << (id1 % WORD_BITS);
 }
 
+// @brief グラフを補グラフに置き換える．
+void
+MaxClique::complement()
+{
+  int rem = mSize % WORD_BITS;
+  for ( int id = 0; id < mSize; ++ id ) {
+    ymuint64* adj = &mAdjArray[id * mWordNum];
+    for ( int w = 0; w < mWordNum; ++ w ) {
+      adj[w] = ~adj[w];
+    }
+    if ( rem != 0 ) {
+      adj[mWordNum - 1] &= (1ULL << rem) - 1;
+    }
+    adj[id / WORD_BITS] &= ~(1ULL << (id % WORD_BITS));
+  }
+}
 
-BEGIN_NONAMESPACE
-
-// left の要素のうち right にも含まれるもののみを残す．
+// @brief solve() での探索ノード数の上限を設定する．
+// @param[in] node_limit 探索ノード数の上限
 void
-merge_nlist(vector<int>& left,
-	    const vector<int>& right)
+MaxClique::set_node_limit(int node_limit)
+{
+  mNodeLimit = node_limit;
+}
+
+// @brief 貪欲法でクリークを求める．
+// @param[out] ans 解のノード番号を入れる配列
+// @return 解のコストを返す．
+double
+MaxClique::greedy(vector<int>& ans)
 {
-#if 0
-  cout << "mrege_nlist" << endl;
-  cout << " left = ";
-  for (vector<int>::iterator p = left.begin();
-       p != left.end(); ++ p) {
-    cout << " " << *p;
+  ans.clear();
+
+  // mTmp1 は候補の集合
+  mTmp1.assign(mWordNum, ~0ULL);
+  int rem = mSize % WORD_BITS;
+  if ( rem != 0 ) {
+    mTmp1[mWordNum - 1] = (1ULL << rem) - 1;
   }
-  cout << endl;
-  cout << " right = ";
-  for (vector<int>::const_iterator p = right.begin();
-       p != right.end(); ++ p) {
-    cout << " " << *p;
+  int cand_num = mSize;
+  double cost = 0.0;
+  while ( cand_num > 0 ) {
+    // 選んだ時に候補に残るノード数を数えて，
+    // cost / (外れるノード数) が最大のものを選ぶ．
+    int best_id = -1;
+    int best_num = 0;
+    for ( int w0 = 0; w0 < mWordNum; ++ w0 ) {
+      for ( ymuint64 bits = mTmp1[w0]; bits != 0ULL; bits &= bits - 1 ) {
+	int id = w0 * WORD_BITS + __builtin_ctzll(bits);
+	const ymuint64* adj = &mAdjArray[id * mWordNum];
+	int num = 0;
+	for ( int w = 0; w < mWordNum; ++ w ) {
+	  num += __builtin_popcountll(mTmp1[w] & adj[w]);
+	}
+	// 外れるノード数は自身を含めて cand_num - num
+	if ( best_id == -1 ||
+	     mCostArray[id] * (cand_num - best_num) >
+	     mCostArray[best_id] * (cand_num - num) ) {
+	  best_id = id;
+	  best_num = num;
+	}
+      }
+    }
+    ans.push_back(best_id);
+    cost += mCostArray[best_id];
+    const ymuint64* adj = &mAdjArray[best_id * mWordNum];
+    for ( int w = 0; w < mWordNum; ++ w ) {
+      mTmp1[w] &= adj[w];
+    }
+    cand_num = best_num;
   }
-  cout << endl;
-#endif
-  vector<int>::iterator l_rpos = left.begin();
-  vector<int>::iterator l_wpos = left.begin();
-  vector<int>::iterator l_end = left.end();
-  vector<int>::const_iterator r_rpos = right.begin();
-  vector<int>::const_iterator r_end = right.end();
-  for ( ; ; ) {
-    if ( l_rpos == l_end ) {
-      break;
+  return cost;
+}
+
+// @brief 最大クリークを求める．
+// @param[out] ans 解のノード番号を入れる配列
+// @return 解のコストを返す．
+double
+MaxClique::solve(vector<int>& ans)
+{
+  return solve(ans, DBL_MAX);
+}
+
+// @brief 打ち切りの値を指定して最大クリークを求める．
+// @param[out] ans 解のノード番号を入れる配列
+// @param[in] limit 打ち切りの値
+// @return 解のコストを返す．
+double
+MaxClique::solve(vector<int>& ans,
+		 double limit)
+{
+  mOptimal = false;
+  mLimit = limit;
+  mBest = greedy(mBestList);
+  if ( mBest < mLimit && mNodeLimit > 0 && mSize > 0 ) {
+    // コストの大きい順(同じなら次数の大きい順)に番号を付け直す．
+    // 彩色では番号の小さいノードから色に入れるので，
+    // 各色の最大コストが小さくなりやすい．
+    vector<int> degree(mSize, 0);
+    for ( int id = 0; id < mSize; ++ id ) {
+      const ymuint64* adj = &mAdjArray[id * mWordNum];
+      for ( int w = 0; w < mWordNum; ++ w ) {
+	degree[id] += __builtin_popcountll(adj[w]);
+      }
     }
-    int l_id = *l_rpos;
-    if ( r_rpos == r_end ) {
-      left.erase(l_wpos, l_end);
-      break;
+    mIdList.resize(mSize);
+    for ( int id = 0; id < mSize; ++ id ) {
+      mIdList[id] = id;
     }
-    int r_id = *r_rpos;
-    if ( l_id < r_id ) {
-      ++ l_rpos;
+    sort(mIdList.begin(), mIdList.end(),
+	 [&](int a, int b) {
+	   if ( mCostArray[a] != mCostArray[b] ) {
+	     return mCostArray[a] > mCostArray[b];
+	   }
+	   return degree[a] > degree[b];
+	 });
+    vector<int> id_map(mSize);
+    mCost.resize(mSize);
+    for ( int id = 0; id < mSize; ++ id ) {
+      id_map[mIdList[id]] = id;
+      mCost[id] = mCostArray[mIdList[id]];
     }
-    else if ( l_id == r_id ) {
-      if ( l_rpos != l_wpos ) {
-	*l_wpos = l_id;
+    mAdj.assign(mSize * mWordNum, 0ULL);
+    for ( int id = 0; id < mSize; ++ id ) {
+      const ymuint64* adj = &mAdjArray[mIdList[id] * mWordNum];
+      ymuint64* adj1 = &mAdj[id * mWordNum];
+      for ( int w = 0; w < mWordNum; ++ w ) {
+	for ( ymuint64 bits = adj[w]; bits != 0ULL; bits &= bits - 1 ) {
+	  int id2 = id_map[w * WORD_BITS + __builtin_ctzll(bits)];
+	  adj1[id2 / WORD_BITS] |= 1ULL << (id2 % WORD_BITS);
+	}
       }
-      ++ l_rpos;
-      ++ l_wpos;
-      ++ r_rpos;
     }
-    else { // l_id > r_id
-      ++ r_rpos;
+
+    // 再帰の深さはクリークの要素数を越えないので，
+    // 作業領域は mSize + 1 段分あればよい．
+    if ( static_cast<int>(mOrderStack.size()) < mSize + 1 ) {
+      mOrderStack.resize(mSize + 1);
+      mBoundStack.resize(mSize + 1);
     }
+    mCandArray.assign((mSize + 1) * mWordNum, 0ULL);
+    mTmp1.resize(mWordNum);
+    mTmp2.resize(mWordNum);
+
+    // 最初の候補は全てのノード
+    for ( int id = 0; id < mSize; ++ id ) {
+      mCandArray[id / WORD_BITS] |= 1ULL << (id % WORD_BITS);
+    }
+    mCurList.clear();
+    mNodeCount = 0;
+    mOptimal = expand(0, 0.0);
   }
-#if 0
-  cout << " result = ";
-  for (vector<int>::iterator p = left.begin();
-       p != left.end(); ++ p) {
-    cout << " " << *p;
+  else if ( mSize == 0 ) {
+    mOptimal = true;
   }
-  cout << endl;
-#endif
+
+  ans = mBestList;
+  return mBest;
 }
 
-END_NONAMESPACE
+// @brief 分枝限定法で探索する．
+// @param[in] level 再帰の深さ
+// @param[in] cost 現在のクリークのコスト
+// @return 打ち切った時には false を返す．
+bool
+MaxClique::expand(int level,
+		  double cost)
+{
+  ++ mNodeCount;
+  if ( mNodeCount > mNodeLimit ) {
+    return false;
+  }
 
+  color(level);
 
-// @brief 最大クリークを求める．
-// @param[out] ans 解のノード番号を入れる配列
-double
-MaxClique::solve(vector<int>& ans)
-{
-  ans.clear();
+  // 上界の大きい(彩色の遅い)ノードから順に候補から外しながら分枝する．
+  // 残りのノードの上界は単調に減るので，mBest を越えられなくなったら終わり．
+  const vector<int>& order = mOrderStack[level];
+  const vector<double>& bound = mBoundStack[level];
+  ymuint64* cand = &mCandArray[level * mWordNum];
+  ymuint64* cand1 = &mCandArray[(level + 1) * mWordNum];
+  for ( int i = order.size(); -- i >= 0; ) {
+    if ( cost + bound[i] <= mBest ) {
+      break;
+    }
+    int id = order[i];
+    double cost1 = cost + mCost[id];
+    mCurList.push_back(id);
 
-  double cost = 0.0;
-  int n = mCostArray.size();
-  vector<bool> mark(n, false);
-  for ( ; ; ) {
-    int min_num = INT_MAX;
-    int min_row = 0;
-    bool found = false;
-    for ( int i = 0; i < n; ++ i ) {
-      if ( mark[i] ) {
-	continue;
+    // 新しい候補は現在の候補のうち id と隣接するもの
+    const ymuint64* adj = &mAdj[id * mWordNum];
+    bool empty = true;
+    for ( int w = 0; w < mWordNum; ++ w ) {
+      cand1[w] = cand[w] & adj[w];
+      if ( cand1[w] != 0ULL ) {
+	empty = false;
       }
-      int num = mNlistArray[i].size();
-      if ( min_num > num ) {
-	min_num = num;
-	min_row = i;
-	found = true;
+    }
+    if ( empty ) {
+      if ( mBest < cost1 ) {
+	mBest = cost1;
+	mBestList.clear();
+	for ( auto id1: mCurList ) {
+	  mBestList.push_back(mIdList[id1]);
+	}
+	if ( mBest >= mLimit ) {
+	  return false;
+	}
       }
     }
-    if ( !found ) {
-      break;
+    else if ( !expand(level + 1, cost1) ) {
+      return false;
     }
 
-    ans.push_back(min_row);
-    mark[min_row] = true;
+    mCurList.pop_back();
+    cand[id / WORD_BITS] &= ~(1ULL << (id % WORD_BITS));
+  }
+  return true;
+}
+
+// @brief 候補の集合を彩色して探索順と上界を求める．
+// @param[in] level 再帰の深さ
+void
+MaxClique::color(int level)
+{
+  vector<int>& order = mOrderStack[level];
+  vector<double>& bound = mBoundStack[level];
+  order.clear();
+  bound.clear();
 
-    for ( auto row: mNlistArray[min_row] ) {
-      mark[row] = true;
+  // mTmp1 は未彩色のノードの集合
+  // mTmp2 は現在の色に入れられるノードの集合
+  const ymuint64* cand = &mCandArray[level * mWordNum];
+  for ( int w = 0; w < mWordNum; ++ w ) {
+    mTmp1[w] = cand[w];
+  }
+  double sum = 0.0;
+  for ( int w0 = 0; w0 < mWordNum; ) {
+    if ( mTmp1[w0] == 0ULL ) {
+      ++ w0;
+      continue;
     }
-    cost += mCostArray[min_row];
+    for ( int w = w0; w < mWordNum; ++ w ) {
+      mTmp2[w] = mTmp1[w];
+    }
+    double max_cost = 0.0;
+    for ( int w = w0; w < mWordNum; ++ w ) {
+      while ( mTmp2[w] != 0ULL ) {
+	int b = __builtin_ctzll(mTmp2[w]);
+	int id = w * WORD_BITS + b;
+	ymuint64 bit = 1ULL << b;
+	mTmp1[w] &= ~bit;
+	order.push_back(id);
+	if ( max_cost < mCost[id] ) {
+	  max_cost = mCost[id];
+	}
+	// id と隣接するノードは同じ色にできない．
+	const ymuint64* adj = &mAdj[id * mWordNum];
+	for ( int w1 = w; w1 < mWordNum; ++ w1 ) {
+	  mTmp2[w1] &= ~adj[w1];
+	}
+	mTmp2[w] &= ~bit;
+      }
+    }
+    sum += max_cost;
+    bound.resize(order.size(), sum);
   }
-  return cost;
 }
 
 END_NAMESPACE_YM_MINCOV
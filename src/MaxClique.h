@@ -15,7 +15,19 @@ BEGIN_NAMESPACE_YM_MINCOV
 
 //////////////////////////////////////////////////////////////////////
 /// @class MaxClique MaxClique.h "MaxClique.h"
-/// @brief 最大クリーク問題を解くクラス
+/// @brief 重み付き最大クリーク問題を解くクラス
+///
+/// 各ノードの隣接関係を 64 ビットのワードのビットベクタで表し，
+/// 候補の集合の積をワード単位で計算する．
+///
+/// solve() は貪欲彩色による上界を用いた分枝限定法(Tomita, San Segundo の
+/// 方法を重み付きにしたもの)で，同じ色のノードは互いに隣接しないので
+/// クリークは各色から高々一つのノードしか含まないことを利用して
+/// 色ごとの最大コストの和を上界とする．
+/// 探索ノード数が上限に達した時はそれまでに見つかった最良の解を返す．
+/// greedy() は分枝をしない貪欲法で，solve() の初期解にも用いる．
+///
+/// 独立集合を求める時は衝突する組を connect() してから complement() を呼ぶ．
 //////////////////////////////////////////////////////////////////////
 class MaxClique
 {
@@ -23,6 +35,8 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] size ノード数
+  ///
+  /// 全てのノードのコストは 1.0 で，枝はない．
   MaxClique(int size);
 
   /// @brief デストラクタ
@@ -34,36 +48,185 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 初期化する．
+  /// @param[in] size ノード数
+  ///
+  /// コンストラクタ直後と同じ状態になる．
+  void
+  init(int size);
+
+  /// @brief ノード数を返す．
+  int
+  size() const;
+
   /// @brief コストを設定する．
+  /// @param[in] id ノード番号 ( 0 <= id < size() )
+  /// @param[in] cost コスト ( cost >= 0.0 )
   void
   set_cost(int id,
 	   double cost);
 
   /// @brief 2つのノードを隣接させる．
   /// @param[in] id1, id2 ノード番号
+  ///
+  /// id1 == id2 の時は何もしない．
   void
   connect(int id1,
 	  int id2);
 
+  /// @brief グラフを補グラフに置き換える．
+  void
+  complement();
+
+  /// @brief solve() での探索ノード数の上限を設定する．
+  /// @param[in] node_limit 探索ノード数の上限
+  void
+  set_node_limit(int node_limit);
+
+  /// @brief 貪欲法でクリークを求める．
+  /// @param[out] ans 解のノード番号を入れる配列
+  /// @return 解のコストを返す．
+  ///
+  /// 選ぶと候補から外れるノードの数に対して自身のコストが
+  /// 最も大きいノードを順に選ぶ．
+  double
+  greedy(vector<int>& ans);
+
   /// @brief 最大クリークを求める．
   /// @param[out] ans 解のノード番号を入れる配列
+  /// @return 解のコストを返す．
   double
   solve(vector<int>& ans);
 
+  /// @brief 打ち切りの値を指定して最大クリークを求める．
+  /// @param[out] ans 解のノード番号を入れる配列
+  /// @param[in] limit 打ち切りの値
+  /// @return 解のコストを返す．
+  ///
+  /// コストが limit 以上のクリークが見つかった時点で探索を打ち切る．
+  double
+  solve(vector<int>& ans,
+	double limit);
+
+  /// @brief 直前の solve() で最適解が得られた時 true を返す．
+  ///
+  /// 探索ノード数の上限か打ち切りの値で探索を止めた時は false となる．
+  bool
+  is_optimal() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 分枝限定法で探索する．
+  /// @param[in] level 再帰の深さ
+  /// @param[in] cost 現在のクリークのコスト
+  /// @return 打ち切った時には false を返す．
+  ///
+  /// 候補の集合は mCandArray の level 番目のブロックに入っている．
+  bool
+  expand(int level,
+	 double cost);
+
+  /// @brief 候補の集合を彩色して探索順と上界を求める．
+  /// @param[in] level 再帰の深さ
+  ///
+  /// 結果は mOrderStack[level] と mBoundStack[level] に入る．
+  void
+  color(int level);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // ノード数
+  int mSize;
+
+  // ビットベクタのワード数
+  int mWordNum;
+
   // コストの配列
   vector<double> mCostArray;
 
-  // 隣接ノードリストの配列
-  vector<vector<int> > mNlistArray;
+  // 隣接関係のビットベクタ
+  // mSize 個のブロックからなり，各ブロックは mWordNum 個のワードからなる．
+  vector<ymuint64> mAdjArray;
+
+  // solve() での探索ノード数の上限
+  int mNodeLimit;
+
+  // 直前の solve() で最適解が得られた時 true にする．
+  bool mOptimal;
+
+  //////////////////////////////////////////////////////////////////////
+  // 以下は solve() の作業領域
+  // ノードはコストの大きい順に番号を付け直しておく．
+  //////////////////////////////////////////////////////////////////////
+
+  // 新しい番号から元の番号への変換表
+  vector<int> mIdList;
+
+  // 新しい番号でのコストの配列
+  vector<double> mCost;
+
+  // 新しい番号での隣接関係のビットベクタ
+  vector<ymuint64> mAdj;
+
+  // 探索ノード数
+  int mNodeCount;
+
+  // 打ち切りの値
+  double mLimit;
+
+  // これまでに見つかった最良のコスト
+  double mBest;
+
+  // 現在のクリーク
+  vector<int> mCurList;
+
+  // 最良のクリーク
+  vector<int> mBestList;
+
+  // 再帰の深さごとの候補の集合
+  vector<ymuint64> mCandArray;
+
+  // 彩色で用いる作業用のビットベクタ
+  vector<ymuint64> mTmp1;
+  vector<ymuint64> mTmp2;
+
+  // 再帰の深さごとの探索順のノードのリスト
+  vector<vector<int> > mOrderStack;
+
+  // 再帰の深さごとの mOrderStack の各ノードに対する上界
+  vector<vector<double> > mBoundStack;
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノード数を返す．
+inline
+int
+MaxClique::size() const
+{
+  return mSize;
+}
+
+// @brief 直前の solve() で最適解が得られた時 true を返す．
+inline
+bool
+MaxClique::is_optimal() const
+{
+  return mOptimal;
+}
+
 END_NAMESPACE_YM_MINCOV
 
 #endif // MAXCLIQUE_H
@@ -10,7 +10,6 @@
 
 
 #include "ym/ym_mincov.h"
-#include "ym/UnitAlloc.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -18,6 +17,11 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class McCell McCell.h "McCell.h"
 /// @brief mincov 用の行列要素を表すクラス
+///
+/// McCell は McMatrix の持つ連続した配列上に確保される．
+/// 上下左右のリンクはポインタではなく，同じ配列上での自分自身からの
+/// 相対位置を 32 ビットの整数で保持する．
+/// そのため配列ごとコピーしてもリンクは正しく保たれる．
 //////////////////////////////////////////////////////////////////////
 class McCell
 {
@@ -63,6 +67,53 @@ public:
   const McCell*
   col_next() const;
 
+  /// @brief 行/列のシグネチャ用のビットを返す．
+  /// @param[in] pos 行番号もしくは列番号
+  ///
+  /// 行(列)のシグネチャはその行(列)に含まれる列(行)番号の
+  /// sig_bit() の OR で，包含関係の高速な否定判定に用いる．
+  static
+  ymuint64
+  sig_bit(int pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // McRowHead, McColHead, McMatrix から用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 左隣の要素を返す．
+  McCell*
+  left();
+
+  /// @brief 右隣の要素を返す．
+  McCell*
+  right();
+
+  /// @brief 上の要素を返す．
+  McCell*
+  up();
+
+  /// @brief 下の要素を返す．
+  McCell*
+  down();
+
+  /// @brief 左隣の要素を設定する．
+  void
+  set_left(McCell* cell);
+
+  /// @brief 右隣の要素を設定する．
+  void
+  set_right(McCell* cell);
+
+  /// @brief 上の要素を設定する．
+  void
+  set_up(McCell* cell);
+
+  /// @brief 下の要素を設定する．
+  void
+  set_down(McCell* cell);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -75,17 +126,17 @@ private:
   // 列番号
   int mColPos;
 
-  // 左隣の要素
-  McCell* mLeftLink;
+  // 左隣の要素の相対位置
+  int mLeftLink;
 
-  // 右隣の要素
-  McCell* mRightLink;
+  // 右隣の要素の相対位置
+  int mRightLink;
 
-  // 上の要素
-  McCell* mUpLink;
+  // 上の要素の相対位置
+  int mUpLink;
 
-  // 下の要素
-  McCell* mDownLink;
+  // 下の要素の相対位置
+  int mDownLink;
 
 };
 
@@ -127,7 +178,7 @@ inline
 const McCell*
 McCell::row_prev() const
 {
-  return mLeftLink;
+  return this + mLeftLink;
 }
 
 // @brief 同じ行の直後の要素を返す．
@@ -135,7 +186,7 @@ inline
 const McCell*
 McCell::row_next() const
 {
-  return mRightLink;
+  return this + mRightLink;
 }
 
 // @brief 同じ列の直前の要素を返す．
@@ -143,7 +194,7 @@ inline
 const McCell*
 McCell::col_prev() const
 {
-  return mUpLink;
+  return this + mUpLink;
 }
 
 // @brief 同じ列の直後の要素を返す．
@@ -151,7 +202,82 @@ inline
 const McCell*
 McCell::col_next() const
 {
-  return mDownLink;
+  return this + mDownLink;
+}
+
+// @brief 左隣の要素を返す．
+inline
+McCell*
+McCell::left()
+{
+  return this + mLeftLink;
+}
+
+// @brief 右隣の要素を返す．
+inline
+McCell*
+McCell::right()
+{
+  return this + mRightLink;
+}
+
+// @brief 上の要素を返す．
+inline
+McCell*
+McCell::up()
+{
+  return this + mUpLink;
+}
+
+// @brief 下の要素を返す．
+inline
+McCell*
+McCell::down()
+{
+  return this + mDownLink;
+}
+
+// @brief 左隣の要素を設定する．
+inline
+void
+McCell::set_left(McCell* cell)
+{
+  mLeftLink = cell - this;
+}
+
+// @brief 右隣の要素を設定する．
+inline
+void
+McCell::set_right(McCell* cell)
+{
+  mRightLink = cell - this;
+}
+
+// @brief 上の要素を設定する．
+inline
+void
+McCell::set_up(McCell* cell)
+{
+  mUpLink = cell - this;
+}
+
+// @brief 下の要素を設定する．
+inline
+void
+McCell::set_down(McCell* cell)
+{
+  mDownLink = cell - this;
+}
+
+// @brief 行/列のシグネチャ用のビットを返す．
+// @param[in] pos 行番号もしくは列番号
+inline
+ymuint64
+McCell::sig_bit(int pos)
+{
+  // 連続した番号が同じビットに偏らないように乗算ハッシュの上位6ビットを使う．
+  ymuint64 h = static_cast<ymuint64>(pos) * 0x9E3779B97F4A7C15ULL;
+  return 1ULL << (h >> 58);
 }
 
 END_NAMESPACE_YM_MINCOV
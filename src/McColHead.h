@@ -12,7 +12,6 @@
 #include "ym/ym_mincov.h"
 
 #include "McCell.h"
-#include "ym/UnitAlloc.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -28,8 +27,8 @@ class McColHead
 private:
 
   /// @brief コンストラクタ
-  /// @param[in] pos 列番号
-  McColHead(int pos);
+  /// @note 実際の値は init() で設定する．
+  McColHead();
 
   /// @brief デストラクタ
   ~McColHead();
@@ -71,16 +70,20 @@ public:
   next() const;
 
 
-public:
-
-  mutable
-  int mWork;
-
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 初期化する．
+  /// @param[in] pos 列番号
+  /// @param[in] dummy ダミーヘッダとして用いる要素
+  ///
+  /// 接続している要素はクリアされる．
+  void
+  init(int pos,
+       McCell* dummy);
+
   /// @brief 接続している要素をクリアする．
   void
   clear();
@@ -117,7 +120,8 @@ private:
   int mNum;
 
   // 二重連結リストのダミーヘッダ
-  McCell mDummy;
+  // 実体は McMatrix のセルの配列上にある．
+  McCell* mDummy;
 
   // 直前の列を指すリンク
   McColHead* mPrev;
@@ -127,6 +131,14 @@ private:
 
   // 削除フラグ
   bool mDeleted;
+
+  // McMatrix::reduce() で調べ直す必要がある時 true にするフラグ
+  bool mDirty;
+
+  // 要素の行番号のシグネチャ
+  // 要素の追加と復元の時に OR するだけなので，削除の後は
+  // 実際のシグネチャを包含する値になっている．
+  ymuint64 mSig;
 };
 
 
@@ -135,17 +147,17 @@ private:
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] pos 列番号
 inline
-McColHead::McColHead(int pos) :
-  mPos(pos),
+McColHead::McColHead() :
+  mPos(0),
   mNum(0),
+  mDummy(nullptr),
   mPrev(nullptr),
   mNext(nullptr),
-  mDeleted(false)
+  mDeleted(false),
+  mDirty(false),
+  mSig(0ULL)
 {
-  mDummy.mUpLink = &mDummy;
-  mDummy.mDownLink = &mDummy;
 }
 
 /// @brief デストラクタ
@@ -175,7 +187,7 @@ inline
 const McCell*
 McColHead::front() const
 {
-  return mDummy.mDownLink;
+  return mDummy->down();
 }
 
 // @brief 末尾の要素を返す．
@@ -183,7 +195,7 @@ inline
 const McCell*
 McColHead::back() const
 {
-  return mDummy.mUpLink;
+  return mDummy->up();
 }
 
 // @brief cell が終端かどうか調べる．
@@ -193,7 +205,7 @@ inline
 bool
 McColHead::is_end(const McCell* cell) const
 {
-  return cell == &mDummy;
+  return cell == mDummy;
 }
 
 // @brief 直前の列を返す．
@@ -212,13 +224,31 @@ McColHead::next() const
   return mNext;
 }
 
+// @brief 初期化する．
+// @param[in] pos 列番号
+// @param[in] dummy ダミーヘッダとして用いる要素
+inline
+void
+McColHead::init(int pos,
+		McCell* dummy)
+{
+  mPos = pos;
+  mDummy = dummy;
+  mPrev = nullptr;
+  mNext = nullptr;
+  mDeleted = false;
+  mDirty = false;
+  mSig = 0ULL;
+  clear();
+}
+
 // @brief 接続している要素をクリアする．
 inline
 void
 McColHead::clear()
 {
-  mDummy.mUpLink = &mDummy;
-  mDummy.mDownLink = &mDummy;
+  mDummy->set_up(mDummy);
+  mDummy->set_down(mDummy);
   mNum = 0;
 }
 
@@ -229,15 +259,16 @@ inline
 void
 McColHead::insert_elem(McCell* cell)
 {
-  McCell* prev = cell->mUpLink;
-  McCell* next = cell->mDownLink;
+  McCell* prev = cell->up();
+  McCell* next = cell->down();
 
-  if ( prev->mDownLink != cell ) {
+  if ( prev->down() != cell ) {
     ++ mNum;
   }
+  mSig |= McCell::sig_bit(cell->row_pos());
 
-  prev->mDownLink = cell;
-  next->mUpLink = cell;
+  prev->set_down(cell);
+  next->set_up(cell);
 }
 
 // @brief 要素を削除する．
@@ -246,11 +277,11 @@ inline
 void
 McColHead::delete_elem(McCell* cell)
 {
-  McCell* prev = cell->mUpLink;
-  McCell* next = cell->mDownLink;
+  McCell* prev = cell->up();
+  McCell* next = cell->down();
 
-  prev->mDownLink = next;
-  next->mUpLink = prev;
+  prev->set_down(next);
+  next->set_up(prev);
   -- mNum;
 }
 
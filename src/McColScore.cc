@@ -0,0 +1,269 @@
+﻿
+/// @file McColScore.cc
+/// @brief McColScore の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McColScore.h"
+#include "McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス McColScore
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] matrix 対象の行列
+McColScore::McColScore(const McMatrix& matrix) :
+  mScoreArray(matrix.col_size(), 0.0),
+  mHeapPos(matrix.col_size(), -1),
+  mDirty(matrix.col_size(), false)
+{
+  mHeap.reserve(matrix.col_num());
+  for ( const McColHead* col = matrix.col_front();
+	!matrix.is_col_end(col); col = col->next() ) {
+    int col_pos = col->pos();
+    mScoreArray[col_pos] = calc_score(matrix, col_pos);
+    heap_put(col_pos);
+  }
+}
+
+// @brief デストラクタ
+McColScore::~McColScore()
+{
+}
+
+// @brief 評価値が最大の列を返す．
+// @param[in] matrix 対象の行列
+int
+McColScore::max_col(const McMatrix& matrix)
+{
+  for ( auto col_pos: mDirtyList ) {
+    mDirty[col_pos] = false;
+    if ( mHeapPos[col_pos] != -1 ) {
+      heap_update(col_pos, calc_score(matrix, col_pos));
+    }
+  }
+  mDirtyList.clear();
+
+  if ( mHeap.empty() ) {
+    return -1;
+  }
+  return mHeap[0];
+}
+
+// @brief 行が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+//
+// 行の要素のリストは削除された時点のまま残っている．
+void
+McColScore::row_deleted(const McMatrix& matrix,
+			int row_pos)
+{
+  set_row_dirty(matrix, row_pos);
+}
+
+// @brief 列が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// 列に含まれていた行は要素数が一つ減っているので，
+// それらの行の残りの列の値が変わる．
+void
+McColScore::col_deleted(const McMatrix& matrix,
+			int col_pos)
+{
+  heap_erase(col_pos);
+  const McColHead* col = matrix.col(col_pos);
+  for ( const McCell* cell = col->front();
+	!col->is_end(cell); cell = cell->col_next() ) {
+    set_row_dirty(matrix, cell->row_pos());
+  }
+}
+
+// @brief 行が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+void
+McColScore::row_restored(const McMatrix& matrix,
+			 int row_pos)
+{
+  set_row_dirty(matrix, row_pos);
+}
+
+// @brief 列が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// 評価値は削除前のものを仮に用いて max_col() で求め直す．
+void
+McColScore::col_restored(const McMatrix& matrix,
+			 int col_pos)
+{
+  heap_put(col_pos);
+  set_dirty(col_pos);
+  const McColHead* col = matrix.col(col_pos);
+  for ( const McCell* cell = col->front();
+	!col->is_end(cell); cell = cell->col_next() ) {
+    set_row_dirty(matrix, cell->row_pos());
+  }
+}
+
+// @brief 列の評価値を求める．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// SelSimple と同じ順序で同じ式を用いる．
+double
+McColScore::calc_score(const McMatrix& matrix,
+		       int col_pos) const
+{
+  const McColHead* col = matrix.col(col_pos);
+  double weight = 0.0;
+  for ( const McCell* cell = col->front();
+	!col->is_end(cell); cell = cell->col_next() ) {
+    const McRowHead* row = matrix.row(cell->row_pos());
+    weight += (1.0 / (row->num() - 1.0));
+  }
+  weight /= matrix.col_cost(col_pos);
+  return weight;
+}
+
+// @brief 列の値が変わりうることを記録する．
+void
+McColScore::set_dirty(int col_pos)
+{
+  if ( !mDirty[col_pos] ) {
+    mDirty[col_pos] = true;
+    mDirtyList.push_back(col_pos);
+  }
+}
+
+// @brief 行に含まれる列の値が変わりうることを記録する．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+void
+McColScore::set_row_dirty(const McMatrix& matrix,
+			  int row_pos)
+{
+  const McRowHead* row = matrix.row(row_pos);
+  for ( const McCell* cell = row->front();
+	!row->is_end(cell); cell = cell->row_next() ) {
+    set_dirty(cell->col_pos());
+  }
+}
+
+// @brief col_pos1 の方が優先される時 true を返す．
+bool
+McColScore::better(int col_pos1,
+		   int col_pos2) const
+{
+  double score1 = mScoreArray[col_pos1];
+  double score2 = mScoreArray[col_pos2];
+  if ( score1 != score2 ) {
+    return score1 > score2;
+  }
+  return col_pos1 < col_pos2;
+}
+
+// @brief ヒープに列を加える．
+void
+McColScore::heap_put(int col_pos)
+{
+  ASSERT_COND( mHeapPos[col_pos] == -1 );
+  int pos = mHeap.size();
+  mHeap.push_back(col_pos);
+  mHeapPos[col_pos] = pos;
+  move_up(pos);
+}
+
+// @brief ヒープから列を取り除く．
+void
+McColScore::heap_erase(int col_pos)
+{
+  int pos = mHeapPos[col_pos];
+  ASSERT_COND( pos != -1 );
+  mHeapPos[col_pos] = -1;
+  int last = mHeap.back();
+  mHeap.pop_back();
+  if ( last != col_pos ) {
+    heap_set(pos, last);
+    move_up(pos);
+    move_down(mHeapPos[last]);
+  }
+}
+
+// @brief 列の評価値を変えてヒープの位置を直す．
+// @param[in] col_pos 列番号
+// @param[in] score 新しい評価値
+void
+McColScore::heap_update(int col_pos,
+			double score)
+{
+  int pos = mHeapPos[col_pos];
+  ASSERT_COND( pos != -1 );
+  if ( score == mScoreArray[col_pos] ) {
+    return;
+  }
+  mScoreArray[col_pos] = score;
+  move_up(pos);
+  move_down(mHeapPos[col_pos]);
+}
+
+// @brief ヒープの要素を根の方向に動かす．
+void
+McColScore::move_up(int pos)
+{
+  int col_pos = mHeap[pos];
+  while ( pos > 0 ) {
+    int parent = (pos - 1) / 2;
+    int col_pos1 = mHeap[parent];
+    if ( !better(col_pos, col_pos1) ) {
+      break;
+    }
+    heap_set(pos, col_pos1);
+    pos = parent;
+  }
+  heap_set(pos, col_pos);
+}
+
+// @brief ヒープの要素を葉の方向に動かす．
+void
+McColScore::move_down(int pos)
+{
+  int n = mHeap.size();
+  int col_pos = mHeap[pos];
+  for ( ; ; ) {
+    int child = pos * 2 + 1;
+    if ( child >= n ) {
+      break;
+    }
+    if ( child + 1 < n && better(mHeap[child + 1], mHeap[child]) ) {
+      ++ child;
+    }
+    int col_pos1 = mHeap[child];
+    if ( !better(col_pos1, col_pos) ) {
+      break;
+    }
+    heap_set(pos, col_pos1);
+    pos = child;
+  }
+  heap_set(pos, col_pos);
+}
+
+// @brief ヒープの位置に列を置く．
+void
+McColScore::heap_set(int pos,
+		     int col_pos)
+{
+  mHeap[pos] = col_pos;
+  mHeapPos[col_pos] = pos;
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,200 @@
+﻿#ifndef MCCOLSCORE_H
+#define MCCOLSCORE_H
+
+/// @file McColScore.h
+/// @brief McColScore のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McMatrixListener.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McColScore McColScore.h "McColScore.h"
+/// @brief SelSimple の列の評価値を保持するクラス
+///
+/// 列の評価値はその列が被覆する各行の 1 / (行の要素数 - 1) の和を
+/// 列のコストで割ったもの．要素数が 1 の行を含む列は無限大になる．
+///
+/// 行や列が削除/復元された時は値の変わりうる列に印をつけるだけにして，
+/// max_col() の時に印のついた列の値を要素のリストから求め直す．
+/// SelSimple が全ての列を調べる時と同じ順序で和をとるので，
+/// 評価値はビット単位で一致する．
+/// 評価値の最大の列を添字付きのヒープで管理する．
+/// 値が等しい時は列番号の小さいものを優先するので，
+/// 列のリストを順に調べて最初の最大値を選ぶのと同じ列になる．
+//////////////////////////////////////////////////////////////////////
+class McColScore :
+  public McMatrixListener
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] matrix 対象の行列
+  ///
+  /// matrix の現在の内容から評価値を求める．
+  explicit
+  McColScore(const McMatrix& matrix);
+
+  /// @brief デストラクタ
+  virtual
+  ~McColScore();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 評価値が最大の列を返す．
+  /// @param[in] matrix 対象の行列
+  ///
+  /// 値の変わりうる列の評価値をここで求め直す．
+  /// 削除されていない列がない時は -1 を返す．
+  int
+  max_col(const McMatrix& matrix);
+
+  /// @brief 列の評価値を返す．
+  /// @param[in] col_pos 列番号
+  ///
+  /// 最後に max_col() を呼んだ時点の値を返す．
+  /// 削除されていない列に対してのみ意味を持つ．
+  double
+  score(int col_pos) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McMatrixListener の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された．
+  virtual
+  void
+  row_deleted(const McMatrix& matrix,
+	      int row_pos);
+
+  /// @brief 列が削除された．
+  virtual
+  void
+  col_deleted(const McMatrix& matrix,
+	      int col_pos);
+
+  /// @brief 行が復元される．
+  virtual
+  void
+  row_restored(const McMatrix& matrix,
+	       int row_pos);
+
+  /// @brief 列が復元される．
+  virtual
+  void
+  col_restored(const McMatrix& matrix,
+	       int col_pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 列の評価値を求める．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] col_pos 列番号
+  double
+  calc_score(const McMatrix& matrix,
+	     int col_pos) const;
+
+  /// @brief 列の値が変わりうることを記録する．
+  void
+  set_dirty(int col_pos);
+
+  /// @brief 行に含まれる列の値が変わりうることを記録する．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] row_pos 行番号
+  void
+  set_row_dirty(const McMatrix& matrix,
+		int row_pos);
+
+  /// @brief col_pos1 の方が優先される時 true を返す．
+  bool
+  better(int col_pos1,
+	 int col_pos2) const;
+
+  /// @brief ヒープに列を加える．
+  ///
+  /// その時点の mScoreArray の値をヒープ用の値とする．
+  void
+  heap_put(int col_pos);
+
+  /// @brief ヒープから列を取り除く．
+  void
+  heap_erase(int col_pos);
+
+  /// @brief 列の評価値を変えてヒープの位置を直す．
+  /// @param[in] col_pos 列番号
+  /// @param[in] score 新しい評価値
+  void
+  heap_update(int col_pos,
+	      double score);
+
+  /// @brief ヒープの要素を根の方向に動かす．
+  void
+  move_up(int pos);
+
+  /// @brief ヒープの要素を葉の方向に動かす．
+  void
+  move_down(int pos);
+
+  /// @brief ヒープの位置に列を置く．
+  void
+  heap_set(int pos,
+	   int col_pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 各列の評価値の配列
+  // 値が変わってから max_col() が呼ばれるまでは古い値のままとなる．
+  vector<double> mScoreArray;
+
+  // 評価値の大きい列が根にくるヒープ
+  vector<int> mHeap;
+
+  // 各列のヒープ中の位置の配列
+  // ヒープに含まれない列は -1 となる．
+  vector<int> mHeapPos;
+
+  // 値の変わりうる列の時 true となる配列
+  vector<bool> mDirty;
+
+  // 値の変わりうる列のリスト
+  vector<int> mDirtyList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 列の評価値を返す．
+// @param[in] col_pos 列番号
+inline
+double
+McColScore::score(int col_pos) const
+{
+  return mScoreArray[col_pos];
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCCOLSCORE_H
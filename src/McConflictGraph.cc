@@ -0,0 +1,232 @@
+﻿
+/// @file McConflictGraph.cc
+/// @brief McConflictGraph の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McConflictGraph.h"
+#include "McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス McConflictGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] matrix 対象の行列
+McConflictGraph::McConflictGraph(const McMatrix& matrix) :
+  mRowSize(matrix.row_size()),
+  mBegin(mRowSize, 0),
+  mEnd(mRowSize, 0),
+  mAdjNum(mRowSize, 0),
+  mActive(mRowSize, false),
+  mRowMark(mRowSize)
+{
+  // 各行について列を共有する行とその列数を数える．
+  // 隣接リストは行番号の昇順に並べておく．
+  vector<int> count_array(mRowSize, 0);
+  vector<int> row_list;
+  for ( const McRowHead* row1 = matrix.row_front();
+	!matrix.is_row_end(row1); row1 = row1->next() ) {
+    int row_pos1 = row1->pos();
+    mActive[row_pos1] = true;
+    row_list.clear();
+    for ( const McCell* cell1 = row1->front();
+	  !row1->is_end(cell1); cell1 = cell1->row_next() ) {
+      const McColHead* col1 = matrix.col(cell1->col_pos());
+      for ( const McCell* cell2 = col1->front();
+	    !col1->is_end(cell2); cell2 = cell2->col_next() ) {
+	int row_pos2 = cell2->row_pos();
+	if ( row_pos2 != row_pos1 && count_array[row_pos2] ++ == 0 ) {
+	  row_list.push_back(row_pos2);
+	}
+      }
+    }
+    sort(row_list.begin(), row_list.end());
+    mBegin[row_pos1] = mAdjRow.size();
+    for ( auto row_pos2: row_list ) {
+      mAdjRow.push_back(row_pos2);
+      mCount.push_back(count_array[row_pos2]);
+      count_array[row_pos2] = 0;
+    }
+    mEnd[row_pos1] = mAdjRow.size();
+    mAdjNum[row_pos1] = row_list.size();
+  }
+
+  // 逆向きの枝の位置を求める．
+  // 行番号の昇順に処理すれば row_pos2 の隣接リスト中の
+  // row_pos2 より小さい行は先頭から順に現れる．
+  mRev.resize(mAdjRow.size());
+  vector<int> cursor(mBegin);
+  for ( int row_pos1 = 0; row_pos1 < mRowSize; ++ row_pos1 ) {
+    for ( int e = mBegin[row_pos1]; e < mEnd[row_pos1]; ++ e ) {
+      int row_pos2 = mAdjRow[e];
+      if ( row_pos2 > row_pos1 ) {
+	int f = cursor[row_pos2];
+	++ cursor[row_pos2];
+	ASSERT_COND( mAdjRow[f] == row_pos1 );
+	mRev[e] = f;
+	mRev[f] = e;
+      }
+    }
+  }
+}
+
+// @brief デストラクタ
+McConflictGraph::~McConflictGraph()
+{
+}
+
+// @brief 行が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+//
+// 隣接する行から row_pos への枝を無効にする．
+// row_pos 自身の隣接リストはそのまま残しておく．
+void
+McConflictGraph::row_deleted(const McMatrix&,
+			     int row_pos)
+{
+  ASSERT_COND( mActive[row_pos] );
+  mActive[row_pos] = false;
+  int end = mBegin[row_pos] + mAdjNum[row_pos];
+  for ( int e = mBegin[row_pos]; e < end; ++ e ) {
+    kill_edge(mAdjRow[e], mRev[e]);
+  }
+}
+
+// @brief 列が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// 列に含まれる行同士の枝の列数を減らし，0 になった枝を無効にする．
+void
+McConflictGraph::col_deleted(const McMatrix& matrix,
+			     int col_pos)
+{
+  mark_rows(matrix, col_pos);
+  if ( mRowList.size() < 2 ) {
+    return;
+  }
+  for ( auto row_pos1: mRowList ) {
+    // 無効にした枝は末尾の(調べ終わった)枝と入れ替わるので
+    // 後ろから調べる．
+    int begin = mBegin[row_pos1];
+    for ( int e = begin + mAdjNum[row_pos1] - 1; e >= begin; -- e ) {
+      if ( mRowMark.check(mAdjRow[e]) ) {
+	-- mCount[e];
+	if ( mCount[e] == 0 ) {
+	  kill_edge(row_pos1, e);
+	}
+      }
+    }
+  }
+}
+
+// @brief 行が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+//
+// row_deleted() で無効にした枝は各隣接リストの無効な枝の先頭にある．
+void
+McConflictGraph::row_restored(const McMatrix&,
+			      int row_pos)
+{
+  ASSERT_COND( !mActive[row_pos] );
+  mActive[row_pos] = true;
+  int end = mBegin[row_pos] + mAdjNum[row_pos];
+  for ( int e = mBegin[row_pos]; e < end; ++ e ) {
+    int row_pos2 = mAdjRow[e];
+    ASSERT_COND( mRev[e] == mBegin[row_pos2] + mAdjNum[row_pos2] );
+    ++ mAdjNum[row_pos2];
+  }
+}
+
+// @brief 列が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// col_deleted() で無効にした枝は各隣接リストの無効な枝の先頭に
+// 列数 0 で並んでいる．
+void
+McConflictGraph::col_restored(const McMatrix& matrix,
+			      int col_pos)
+{
+  mark_rows(matrix, col_pos);
+  if ( mRowList.size() < 2 ) {
+    return;
+  }
+  for ( auto row_pos1: mRowList ) {
+    int begin = mBegin[row_pos1];
+    int end = begin + mAdjNum[row_pos1];
+    for ( int e = begin; e < end; ++ e ) {
+      if ( mRowMark.check(mAdjRow[e]) ) {
+	++ mCount[e];
+      }
+    }
+    for ( int e = end; e < mEnd[row_pos1]; ++ e ) {
+      if ( mCount[e] != 0 || !mRowMark.check(mAdjRow[e]) ) {
+	break;
+      }
+      mCount[e] = 1;
+      ++ mAdjNum[row_pos1];
+    }
+  }
+}
+
+// @brief 列に含まれる有効な行に印をつけて mRowList に入れる．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// 削除された列でも要素のリストは削除された時点のまま残っている．
+void
+McConflictGraph::mark_rows(const McMatrix& matrix,
+			   int col_pos)
+{
+  mRowMark.clear();
+  mRowList.clear();
+  const McColHead* col1 = matrix.col(col_pos);
+  for ( const McCell* cell = col1->front();
+	!col1->is_end(cell); cell = cell->col_next() ) {
+    int row_pos = cell->row_pos();
+    if ( mActive[row_pos] ) {
+      mRowMark.set(row_pos);
+      mRowList.push_back(row_pos);
+    }
+  }
+}
+
+// @brief 枝を無効にする．
+// @param[in] row_pos 枝を持つ行
+// @param[in] e 枝の位置
+void
+McConflictGraph::kill_edge(int row_pos,
+			   int e)
+{
+  int last = mBegin[row_pos] + mAdjNum[row_pos] - 1;
+  ASSERT_COND( e <= last );
+  if ( e != last ) {
+    swap_edge(e, last);
+  }
+  -- mAdjNum[row_pos];
+}
+
+// @brief 枝を入れ替える．
+// @param[in] e1, e2 枝の位置
+void
+McConflictGraph::swap_edge(int e1,
+			   int e2)
+{
+  std::swap(mAdjRow[e1], mAdjRow[e2]);
+  std::swap(mCount[e1], mCount[e2]);
+  std::swap(mRev[e1], mRev[e2]);
+  mRev[mRev[e1]] = e1;
+  mRev[mRev[e2]] = e2;
+}
+
+END_NAMESPACE_YM_MINCOV
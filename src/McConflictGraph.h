@@ -0,0 +1,202 @@
+﻿#ifndef MCCONFLICTGRAPH_H
+#define MCCONFLICTGRAPH_H
+
+/// @file McConflictGraph.h
+/// @brief McConflictGraph のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McMatrixListener.h"
+#include "McMark.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McConflictGraph McConflictGraph.h "McConflictGraph.h"
+/// @brief 行の衝突グラフを表すクラス
+///
+/// 同じ列を共有する行の間に枝を持つグラフ．
+/// 各枝には共有している列の数を持たせておき，行や列の削除/復元に
+/// 合わせて増減させるので，行列を走査し直さずに現在の隣接関係が得られる．
+///
+/// 各行の隣接リストは前半が有効な枝，後半が削除された枝になっており，
+/// 削除された枝は削除の逆順で復元されるので区切りの位置を動かすだけでよい．
+//////////////////////////////////////////////////////////////////////
+class McConflictGraph :
+  public McMatrixListener
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] matrix 対象の行列
+  ///
+  /// matrix の現在の内容からグラフを作る．
+  explicit
+  McConflictGraph(const McMatrix& matrix);
+
+  /// @brief デストラクタ
+  virtual
+  ~McConflictGraph();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行数を返す．
+  int
+  row_size() const;
+
+  /// @brief 隣接する行の数を返す．
+  /// @param[in] row_pos 行番号 ( 0 <= row_pos < row_size() )
+  ///
+  /// 削除されていない行に対してのみ意味を持つ．
+  int
+  adj_num(int row_pos) const;
+
+  /// @brief 隣接する行を返す．
+  /// @param[in] row_pos 行番号 ( 0 <= row_pos < row_size() )
+  /// @param[in] idx 位置番号 ( 0 <= idx < adj_num(row_pos) )
+  int
+  adj_row(int row_pos,
+	  int idx) const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McMatrixListener の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された．
+  virtual
+  void
+  row_deleted(const McMatrix& matrix,
+	      int row_pos);
+
+  /// @brief 列が削除された．
+  virtual
+  void
+  col_deleted(const McMatrix& matrix,
+	      int col_pos);
+
+  /// @brief 行が復元される．
+  virtual
+  void
+  row_restored(const McMatrix& matrix,
+	       int row_pos);
+
+  /// @brief 列が復元される．
+  virtual
+  void
+  col_restored(const McMatrix& matrix,
+	       int col_pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 列に含まれる有効な行に印をつけて mRowList に入れる．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] col_pos 列番号
+  void
+  mark_rows(const McMatrix& matrix,
+	    int col_pos);
+
+  /// @brief 枝を無効にする．
+  /// @param[in] row_pos 枝を持つ行
+  /// @param[in] e 枝の位置
+  ///
+  /// 有効な枝の末尾と入れ替えてから区切りを一つ前に動かす．
+  void
+  kill_edge(int row_pos,
+	    int e);
+
+  /// @brief 枝を入れ替える．
+  /// @param[in] e1, e2 枝の位置
+  ///
+  /// 相手側の枝の逆向きの位置も更新する．
+  void
+  swap_edge(int e1,
+	    int e2);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行数
+  int mRowSize;
+
+  // 各行の隣接リストの開始位置の配列
+  vector<int> mBegin;
+
+  // 各行の隣接リストの終了位置の配列
+  vector<int> mEnd;
+
+  // 各行の有効な枝の数の配列
+  vector<int> mAdjNum;
+
+  // 有効な行の時 true となる配列
+  vector<bool> mActive;
+
+  // 枝の相手の行番号の配列
+  vector<int> mAdjRow;
+
+  // 枝の両端の行が共有している列の数の配列
+  vector<int> mCount;
+
+  // 逆向きの枝の位置の配列
+  vector<int> mRev;
+
+  // 列の削除/復元で用いる行のマーク
+  McMark mRowMark;
+
+  // 列の削除/復元で用いる行のリスト
+  vector<int> mRowList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 行数を返す．
+inline
+int
+McConflictGraph::row_size() const
+{
+  return mRowSize;
+}
+
+// @brief 隣接する行の数を返す．
+// @param[in] row_pos 行番号 ( 0 <= row_pos < row_size() )
+inline
+int
+McConflictGraph::adj_num(int row_pos) const
+{
+  return mAdjNum[row_pos];
+}
+
+// @brief 隣接する行を返す．
+// @param[in] row_pos 行番号 ( 0 <= row_pos < row_size() )
+// @param[in] idx 位置番号 ( 0 <= idx < adj_num(row_pos) )
+inline
+int
+McConflictGraph::adj_row(int row_pos,
+			 int idx) const
+{
+  return mAdjRow[mBegin[row_pos] + idx];
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCCONFLICTGRAPH_H
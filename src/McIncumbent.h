@@ -0,0 +1,138 @@
+﻿#ifndef MCINCUMBENT_H
+#define MCINCUMBENT_H
+
+/// @file McIncumbent.h
+/// @brief McIncumbent のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+#include <atomic>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McIncumbent McIncumbent.h "McIncumbent.h"
+/// @brief 並列探索で共有する暫定解を表すクラス
+///
+/// コストは atomic なので枝刈りのための参照にはロックが要らない．
+/// 解の更新時のみ mutex で保護する．
+//////////////////////////////////////////////////////////////////////
+class McIncumbent
+{
+public:
+
+  /// @brief コンストラクタ
+  McIncumbent();
+
+  /// @brief デストラクタ
+  ~McIncumbent();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 暫定解のコストを返す．
+  ///
+  /// 解が得られていない時は INT_MAX を返す．
+  int
+  cost() const;
+
+  /// @brief 暫定解を返す．
+  ///
+  /// 他のスレッドが update() を呼ばない状態で用いること．
+  const vector<int>&
+  solution() const;
+
+  /// @brief 暫定解を更新する．
+  /// @param[in] cost 解のコスト
+  /// @param[in] solution 解
+  /// @retval true 更新された．
+  /// @retval false cost が暫定解のコスト以上だったので更新されなかった．
+  bool
+  update(int cost,
+	 const vector<int>& solution);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 暫定解のコスト
+  std::atomic<int> mCost;
+
+  // mSolution を保護する mutex
+  std::mutex mMutex;
+
+  // 暫定解
+  vector<int> mSolution;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+McIncumbent::McIncumbent() :
+  mCost(INT_MAX)
+{
+}
+
+// @brief デストラクタ
+inline
+McIncumbent::~McIncumbent()
+{
+}
+
+// @brief 暫定解のコストを返す．
+inline
+int
+McIncumbent::cost() const
+{
+  return mCost;
+}
+
+// @brief 暫定解を返す．
+inline
+const vector<int>&
+McIncumbent::solution() const
+{
+  return mSolution;
+}
+
+// @brief 暫定解を更新する．
+// @param[in] cost 解のコスト
+// @param[in] solution 解
+// @retval true 更新された．
+// @retval false cost が暫定解のコスト以上だったので更新されなかった．
+inline
+bool
+McIncumbent::update(int cost,
+		    const vector<int>& solution)
+{
+  if ( cost >= mCost ) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mMutex);
+  if ( cost >= mCost ) {
+    return false;
+  }
+  mSolution = solution;
+  mCost = cost;
+  return true;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCINCUMBENT_H
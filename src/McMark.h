@@ -0,0 +1,169 @@
+﻿#ifndef MCMARK_H
+#define MCMARK_H
+
+/// @file McMark.h
+/// @brief McMark のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McMark McMark.h "McMark.h"
+/// @brief 行や列に印をつけるための作業領域
+///
+/// 印は世代番号で表すので clear() は世代番号を進めるだけでよい．
+/// McMatrix 自身には書き込まないので，同じ行列を複数のスレッドから
+/// 別々の McMark を用いて同時に調べることができる．
+//////////////////////////////////////////////////////////////////////
+class McMark
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] size 要素数
+  explicit
+  McMark(int size = 0);
+
+  /// @brief デストラクタ
+  ~McMark();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素数を設定する．
+  /// @param[in] size 要素数
+  ///
+  /// 要素数が変わった時のみ領域を確保し直す．
+  /// いずれの場合も全ての印は消される．
+  void
+  resize(int size);
+
+  /// @brief 全ての印を消す．
+  void
+  clear();
+
+  /// @brief 印がついている時 true を返す．
+  /// @param[in] pos 位置番号
+  bool
+  check(int pos) const;
+
+  /// @brief 印をつける．
+  /// @param[in] pos 位置番号
+  void
+  set(int pos);
+
+  /// @brief 印がついていなければ印をつけて true を返す．
+  /// @param[in] pos 位置番号
+  ///
+  /// すでに印がついていた時は false を返す．
+  bool
+  check_and_set(int pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 各要素の世代番号の配列
+  // mEpoch と等しい要素に印がついているとみなす．
+  vector<ymuint> mArray;
+
+  // 現在の世代番号
+  ymuint mEpoch;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] size 要素数
+inline
+McMark::McMark(int size) :
+  mArray(size, 0U),
+  mEpoch(1U)
+{
+}
+
+// @brief デストラクタ
+inline
+McMark::~McMark()
+{
+}
+
+// @brief 要素数を設定する．
+// @param[in] size 要素数
+inline
+void
+McMark::resize(int size)
+{
+  if ( static_cast<int>(mArray.size()) != size ) {
+    mArray.assign(size, 0U);
+    mEpoch = 1U;
+  }
+  else {
+    clear();
+  }
+}
+
+// @brief 全ての印を消す．
+inline
+void
+McMark::clear()
+{
+  ++ mEpoch;
+  if ( mEpoch == 0U ) {
+    // 世代番号が一周したので本当に消す．
+    std::fill(mArray.begin(), mArray.end(), 0U);
+    mEpoch = 1U;
+  }
+}
+
+// @brief 印がついている時 true を返す．
+// @param[in] pos 位置番号
+inline
+bool
+McMark::check(int pos) const
+{
+  return mArray[pos] == mEpoch;
+}
+
+// @brief 印をつける．
+// @param[in] pos 位置番号
+inline
+void
+McMark::set(int pos)
+{
+  mArray[pos] = mEpoch;
+}
+
+// @brief 印がついていなければ印をつけて true を返す．
+// @param[in] pos 位置番号
+inline
+bool
+McMark::check_and_set(int pos)
+{
+  if ( mArray[pos] == mEpoch ) {
+    return false;
+  }
+  mArray[pos] = mEpoch;
+  return true;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCMARK_H
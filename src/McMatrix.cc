@@ -8,7 +8,13 @@
 
 
 #include "McMatrix.h"
+#include "McConflictGraph.h"
+#include "McRowWeight.h"
+#include "McColScore.h"
 #include "McSolverImpl.h"
+#include "McOption.h"
+#include "McMark.h"
+#include <thread>
 
 
 //#define VERIFY_MCMATRIX 1
@@ -16,8 +22,6 @@
 
 BEGIN_NAMESPACE_YM_MINCOV
 
-int mcmatrix_debug = 0;
-
 //////////////////////////////////////////////////////////////////////
 // クラス McRowHead
 //////////////////////////////////////////////////////////////////////
@@ -35,14 +39,14 @@ McRowHead::search_insert_pos(McCell* cell)
   McCell* ncell;
   if ( num() == 0 || back()->col_pos() < col_pos ) {
     // 末尾への追加
-    ncell = &mDummy;
-    pcell = ncell->mLeftLink;
+    ncell = mDummy;
+    pcell = ncell->left();
   }
   else {
     // 追加位置を探索
     // この時点で back->col_pos() >= col_pos が成り立っている．
-    for (pcell = &mDummy; ; pcell = ncell) {
-      ncell = pcell->mRightLink;
+    for (pcell = mDummy; ; pcell = ncell) {
+      ncell = pcell->right();
       if ( ncell->col_pos() == col_pos ) {
 	// 列番号が重複しているので無視する．
 	return false;
@@ -54,8 +58,8 @@ McRowHead::search_insert_pos(McCell* cell)
       ASSERT_COND(!is_end(ncell) );
     }
   }
-  cell->mLeftLink = pcell;
-  cell->mRightLink = ncell;
+  cell->set_left(pcell);
+  cell->set_right(ncell);
 
   return true;
 }
@@ -78,14 +82,14 @@ McColHead::search_insert_pos(McCell* cell)
   McCell* ncell;
   if ( num() == 0 || back()->row_pos() < row_pos ) {
     // 末尾への追加
-    ncell = &mDummy;
-    pcell = ncell->mUpLink;
+    ncell = mDummy;
+    pcell = ncell->up();
   }
   else {
     // 追加位置を探索
     // この時点で back->row_pos() >= row_pos が成り立っている．
-    for (pcell = &mDummy; ; pcell = ncell) {
-      ncell = pcell->mDownLink;
+    for (pcell = mDummy; ; pcell = ncell) {
+      ncell = pcell->down();
       if ( ncell->row_pos() == row_pos ) {
 	// 列番号が重複しているので無視する．
 	return false;
@@ -97,8 +101,8 @@ McColHead::search_insert_pos(McCell* cell)
       ASSERT_COND(!is_end(ncell) );
     }
   }
-  cell->mUpLink = pcell;
-  cell->mDownLink = ncell;
+  cell->set_up(pcell);
+  cell->set_down(ncell);
 
   return true;
 }
@@ -115,15 +119,20 @@ McColHead::search_insert_pos(McCell* cell)
 McMatrix::McMatrix(int row_size,
 		   int col_size,
 		   const int* cost_array) :
-  mCellAlloc(sizeof(McCell), 1024),
   mRowSize(0),
   mColSize(0),
   mRowArray(nullptr),
-  mRowHead(0),
+  mRowHead(),
   mColArray(nullptr),
-  mColHead(0),
+  mColHead(),
+  mCellArray(nullptr),
+  mCellSize(0),
+  mCellNum(0),
+  mOwnArray(true),
   mCostArray(cost_array),
-  mDelStack(nullptr)
+  mConflictGraph(nullptr),
+  mRowWeight(nullptr),
+  mColScore(nullptr)
 {
   mRowNum = 0;
   mColNum = 0;
@@ -133,19 +142,29 @@ McMatrix::McMatrix(int row_size,
 // @brief コピーコンストラクタ
 // @param[in] src コピー元のオブジェクト
 McMatrix::McMatrix(const McMatrix& src) :
-  mCellAlloc(sizeof(McCell), 1024),
   mRowSize(0),
   mColSize(0),
   mRowArray(nullptr),
-  mRowHead(0),
+  mRowHead(),
   mColArray(nullptr),
-  mColHead(0),
-  mDelStack(nullptr)
+  mColHead(),
+  mCellArray(nullptr),
+  mCellSize(0),
+  mCellNum(0),
+  mOwnArray(true),
+  mConflictGraph(nullptr),
+  mRowWeight(nullptr),
+  mColScore(nullptr)
 {
   mRowNum = 0;
   mColNum = 0;
   resize(src.row_size(), src.col_size());
-  copy(src);
+  if ( src.mOwnArray ) {
+    clone(src);
+  }
+  else {
+    copy(src);
+  }
 }
 
 // @brief 部分的なコピーコンストラクタ
@@ -155,25 +174,32 @@ McMatrix::McMatrix(const McMatrix& src) :
 McMatrix::McMatrix(McMatrix& src,
 		   const vector<int>& row_list,
 		   const vector<int>& col_list) :
-  mCellAlloc(sizeof(McCell), 1024),
-  mRowSize(0),
-  mColSize(0),
+  mRowSize(src.row_size()),
+  mColSize(src.col_size()),
   mRowArray(nullptr),
-  mRowHead(0),
+  mRowHead(),
   mColArray(nullptr),
-  mColHead(0),
-  mDelStack(nullptr)
+  mColHead(),
+  mCellArray(nullptr),
+  mCellSize(0),
+  mCellNum(0),
+  mOwnArray(false),
+  mConflictGraph(nullptr),
+  mRowWeight(nullptr),
+  mColScore(nullptr)
 {
   mRowNum = 0;
   mColNum = 0;
-  resize(src.row_size(), src.col_size());
+
+  // 行と列とセルは src のものを共有する．
+  mRowArray = src.mRowArray;
+  mColArray = src.mColArray;
 
   McRowHead* prev_row = &mRowHead;
   for (vector<int>::const_iterator p = row_list.begin();
        p != row_list.end(); ++ p) {
     int row_pos = *p;
-    McRowHead* row1 = src.row(row_pos);
-    mRowArray[row_pos] = row1;
+    McRowHead* row1 = row(row_pos);
     prev_row->mNext = row1;
     row1->mPrev = prev_row;
     prev_row = row1;
@@ -186,8 +212,7 @@ McMatrix::McMatrix(McMatrix& src,
   for (vector<int>::const_iterator p = col_list.begin();
        p != col_list.end(); ++ p) {
     int col_pos = *p;
-    McColHead* col1 = src.col(col_pos);
-    mColArray[col_pos] = col1;
+    McColHead* col1 = col(col_pos);
     prev_col->mNext = col1;
     col1->mPrev = prev_col;
     prev_col = col1;
@@ -207,7 +232,12 @@ McMatrix::operator=(const McMatrix& src)
   if ( this != &src ) {
     clear();
     resize(src.row_size(), src.col_size());
-    copy(src);
+    if ( src.mOwnArray ) {
+      clone(src);
+    }
+    else {
+      copy(src);
+    }
   }
   return *this;
 }
@@ -215,38 +245,30 @@ McMatrix::operator=(const McMatrix& src)
 // @brief デストラクタ
 McMatrix::~McMatrix()
 {
-  for ( int i = 0; i < row_size(); ++ i ) {
-    delete mRowArray[i];
+  if ( mOwnArray ) {
+    delete [] mRowArray;
+    delete [] mColArray;
   }
-  for ( int i = 0; i < col_size(); ++ i ) {
-    delete mColArray[i];
-  }
-  delete [] mRowArray;
-  delete [] mColArray;
-  delete [] mDelStack;
+  delete [] mCellArray;
+  delete mConflictGraph;
+  delete mRowWeight;
+  delete mColScore;
 }
 
 // @brief 内容をクリアする．
 void
 McMatrix::clear()
 {
-  mCellAlloc.destroy();
+  ASSERT_COND( mOwnArray );
 
+  // 行と列のヘッダとダミーヘッダを初期化する．
   for ( int i = 0; i < row_size(); ++ i ) {
-    delete mRowArray[i];
-    mRowArray[i] = nullptr;
+    mRowArray[i].init(i, &mCellArray[i]);
   }
   for ( int i = 0; i < col_size(); ++ i ) {
-    delete mColArray[i];
-    mColArray[i] = nullptr;
+    mColArray[i].init(i, &mCellArray[row_size() + i]);
   }
-
-  delete [] mRowArray;
-  delete [] mColArray;
-  delete [] mDelStack;
-
-  mRowArray = nullptr;
-  mColArray = nullptr;
+  mCellNum = row_size() + col_size();
 
   mRowNum = 0;
   mColNum = 0;
@@ -254,8 +276,18 @@ McMatrix::clear()
   mRowHead.mNext = mRowHead.mPrev = &mRowHead;
   mColHead.mNext = mColHead.mPrev = &mColHead;
 
-  mDelStack = nullptr;
-  mStackTop = 0;
+  mDelStack.clear();
+  mDirtyRowList.clear();
+  mDirtyColList.clear();
+  mDirtyStack.clear();
+
+  mListenerList.clear();
+  delete mConflictGraph;
+  mConflictGraph = nullptr;
+  delete mRowWeight;
+  mRowWeight = nullptr;
+  delete mColScore;
+  mColScore = nullptr;
 }
 
 // @brief サイズを変更する．
@@ -265,32 +297,20 @@ void
 McMatrix::resize(int row_size,
 		 int col_size)
 {
-  if ( mRowSize != row_size || mColSize != col_size ) {
-    clear();
+  if ( mRowArray == nullptr || mRowSize != row_size || mColSize != col_size ) {
+    delete [] mRowArray;
+    delete [] mColArray;
+    delete [] mCellArray;
 
     mRowSize = row_size;
     mColSize = col_size;
-    mRowArray = new McRowHead*[mRowSize];
-    for ( int i = 0; i < mRowSize; ++ i ) {
-      mRowArray[i] = nullptr;
-    }
-    mColArray = new McColHead*[mColSize];
-    for ( int i = 0; i < mColSize; ++ i ) {
-      mColArray[i] = nullptr;
-    }
-
-    mRowHead.mNext = &mRowHead;
-    mRowHead.mPrev = &mRowHead;
-    mRowHead.clear();
+    mRowArray = new McRowHead[mRowSize];
+    mColArray = new McColHead[mColSize];
 
-    mColHead.mNext = &mColHead;
-    mColHead.mPrev = &mColHead;
-    mColHead.clear();
-
-    delete [] mDelStack;
-    mDelStack = new int[row_size + col_size];
-    mStackTop = 0;
+    mCellSize = row_size + col_size;
+    mCellArray = new McCell[mCellSize];
   }
+  clear();
 }
 
 // @brief 内容をコピーする．
@@ -300,6 +320,13 @@ McMatrix::copy(const McMatrix& src)
   ASSERT_COND(row_size() == src.row_size() );
   ASSERT_COND(col_size() == src.col_size() );
 
+  int num = 0;
+  for ( const McRowHead* src_row = src.row_front();
+	!src.is_row_end(src_row); src_row = src_row->next() ) {
+    num += src_row->num();
+  }
+  reserve_cell(num);
+
   for ( const McRowHead* src_row = src.row_front();
 	!src.is_row_end(src_row); src_row = src_row->next() ) {
     int row_pos = src_row->pos();
@@ -313,82 +340,115 @@ McMatrix::copy(const McMatrix& src)
   mCostArray = src.mCostArray;
 }
 
-// @brief 分割した行列をもとに戻す．
+// @brief 内容をそのまま複製する．
+// @param[in] src コピー元のオブジェクト
 void
-McMatrix::merge(McMatrix& matrix1,
-		McMatrix& matrix2)
+McMatrix::clone(const McMatrix& src)
 {
-  McRowHead* prev_row = &mRowHead;
-  McRowHead* row1 = matrix1.mRowHead.mNext;
-  McRowHead* row2 = matrix2.mRowHead.mNext;
-  while ( row1 != &matrix1.mRowHead && row2 != &matrix2.mRowHead ) {
-    if ( row1->pos() < row2->pos() ) {
-      matrix1.mRowArray[row1->pos()] = nullptr;
-      prev_row->mNext = row1;
-      row1->mPrev = prev_row;
-      prev_row = row1;
-      row1 = row1->mNext;
+  ASSERT_COND( mOwnArray && src.mOwnArray );
+  ASSERT_COND( row_size() == src.row_size() );
+  ASSERT_COND( col_size() == src.col_size() );
+
+  // セルのリンクは相対位置なのでそのままコピーすればよい．
+  if ( mCellSize < src.mCellNum ) {
+    delete [] mCellArray;
+    mCellSize = src.mCellNum;
+    mCellArray = new McCell[mCellSize];
+  }
+  mCellNum = src.mCellNum;
+  std::copy(src.mCellArray, src.mCellArray + mCellNum, mCellArray);
+
+  // 行と列のヘッダは src 上のポインタを付け替える．
+  auto conv_row = [&](McRowHead* row1) -> McRowHead* {
+    if ( row1 == nullptr ) {
+      return nullptr;
     }
-    else if ( row1->pos() > row2->pos() ) {
-      matrix2.mRowArray[row2->pos()] = nullptr;
-      prev_row->mNext = row2;
-      row2->mPrev = prev_row;
-      prev_row = row2;
-      row2 = row2->mNext;
+    if ( row1 == &src.mRowHead ) {
+      return &mRowHead;
     }
-    else {
-      ASSERT_NOT_REACHED;
+    return mRowArray + (row1 - src.mRowArray);
+  };
+  auto conv_col = [&](McColHead* col1) -> McColHead* {
+    if ( col1 == nullptr ) {
+      return nullptr;
+    }
+    if ( col1 == &src.mColHead ) {
+      return &mColHead;
+    }
+    return mColArray + (col1 - src.mColArray);
+  };
+
+  for ( int i = 0; i < row_size(); ++ i ) {
+    McRowHead& row1 = mRowArray[i];
+    row1 = src.mRowArray[i];
+    row1.mDummy = &mCellArray[i];
+    row1.mPrev = conv_row(row1.mPrev);
+    row1.mNext = conv_row(row1.mNext);
+  }
+  mRowHead.mPrev = conv_row(src.mRowHead.mPrev);
+  mRowHead.mNext = conv_row(src.mRowHead.mNext);
+  mRowNum = src.mRowNum;
+
+  for ( int i = 0; i < col_size(); ++ i ) {
+    McColHead& col1 = mColArray[i];
+    col1 = src.mColArray[i];
+    col1.mDummy = &mCellArray[row_size() + i];
+    col1.mPrev = conv_col(col1.mPrev);
+    col1.mNext = conv_col(col1.mNext);
+  }
+  mColHead.mPrev = conv_col(src.mColHead.mPrev);
+  mColHead.mNext = conv_col(src.mColHead.mNext);
+  mColNum = src.mColNum;
+
+  mDelStack = src.mDelStack;
+  mDirtyRowList = src.mDirtyRowList;
+  mDirtyColList = src.mDirtyColList;
+  mDirtyStack = src.mDirtyStack;
+  mCostArray = src.mCostArray;
+}
+
+// @brief 分割した行列をもとに戻す．
+// @param[in] matrix_list 部分的なコピーコンストラクタで作られた行列のリスト
+void
+McMatrix::merge(const vector<McMatrix*>& matrix_list)
+{
+  // 行と列のヘッダは共有しているのでリンクをつなぎ直すだけでよい．
+  vector<McRowHead*> row_list;
+  row_list.reserve(row_num());
+  vector<McColHead*> col_list;
+  col_list.reserve(col_num());
+  for ( auto matrix: matrix_list ) {
+    for ( McRowHead* row1 = matrix->mRowHead.mNext;
+	  row1 != &matrix->mRowHead; row1 = row1->mNext ) {
+      row_list.push_back(row1);
+    }
+    for ( McColHead* col1 = matrix->mColHead.mNext;
+	  col1 != &matrix->mColHead; col1 = col1->mNext ) {
+      col_list.push_back(col1);
     }
   }
-  for ( ; row1 != &matrix1.mRowHead; row1 = row1->mNext) {
-    matrix1.mRowArray[row1->pos()] = nullptr;
+  sort(row_list.begin(), row_list.end(),
+       [](const McRowHead* a, const McRowHead* b) { return a->pos() < b->pos(); });
+  sort(col_list.begin(), col_list.end(),
+       [](const McColHead* a, const McColHead* b) { return a->pos() < b->pos(); });
+
+  McRowHead* prev_row = &mRowHead;
+  for ( auto row1: row_list ) {
+    ASSERT_COND( prev_row == &mRowHead || prev_row->pos() < row1->pos() );
     prev_row->mNext = row1;
     row1->mPrev = prev_row;
     prev_row = row1;
   }
-  for ( ; row2 != &matrix2.mRowHead; row2 = row2->mNext) {
-    matrix2.mRowArray[row2->pos()] = nullptr;
-    prev_row->mNext = row2;
-    row2->mPrev = prev_row;
-    prev_row = row2;
-  }
   prev_row->mNext = &mRowHead;
   mRowHead.mPrev = prev_row;
 
   McColHead* prev_col = &mColHead;
-  McColHead* col1 = matrix1.mColHead.mNext;
-  McColHead* col2 = matrix2.mColHead.mNext;
-  while ( col1 != &matrix1.mColHead && col2 != &matrix2.mColHead ) {
-    if ( col1->pos() < col2->pos() ) {
-      matrix1.mColArray[col1->pos()] = nullptr;
-      prev_col->mNext = col1;
-      col1->mPrev = prev_col;
-      prev_col = col1;
-      col1 = col1->mNext;
-    }
-    else if ( col1->pos() > col2->pos() ) {
-      matrix2.mColArray[col2->pos()] = nullptr;
-      prev_col->mNext = col2;
-      col2->mPrev = prev_col;
-      prev_col = col2;
-      col2 = col2->mNext;
-    }
-    else {
-      ASSERT_NOT_REACHED;
-    }
-  }
-  for ( ; col1 != &matrix1.mColHead; col1 = col1->mNext) {
-    matrix1.mColArray[col1->pos()] = nullptr;
+  for ( auto col1: col_list ) {
+    ASSERT_COND( prev_col == &mColHead || prev_col->pos() < col1->pos() );
     prev_col->mNext = col1;
     col1->mPrev = prev_col;
     prev_col = col1;
   }
-  for ( ; col2 != &matrix2.mColHead; col2 = col2->mNext) {
-    matrix2.mColArray[col2->pos()] = nullptr;
-    prev_col->mNext = col2;
-    col2->mPrev = prev_col;
-    prev_col = col2;
-  }
   prev_col->mNext = &mColHead;
   mColHead.mPrev = prev_col;
 }
@@ -428,114 +488,72 @@ McMatrix::cost(const vector<int>& col_list) const
 }
 
 // @brief ブロック分割を行う．
-// @param[in] row_list1 1つめのブロックの行番号のリスト
-// @param[in] row_list2 2つめのブロックの行番号のリスト
-// @param[in] col_list1 1つめのブロックの列番号のリスト
-// @param[in] col_list2 2つめのブロックの列番号のリスト
-// @retval true ブロック分割が行われた．
+// @param[out] row_list_array 各ブロックの行番号のリストの配列
+// @param[out] col_list_array 各ブロックの列番号のリストの配列
+// @retval true 2つ以上のブロックに分割された．
 // @retval false ブロック分割が行えなかった．
 bool
-McMatrix::block_partition(vector<int>& row_list1,
-			  vector<int>& row_list2,
-			  vector<int>& col_list1,
-			  vector<int>& col_list2) const
+McMatrix::block_partition(vector<vector<int>>& row_list_array,
+			  vector<vector<int>>& col_list_array) const
 {
-  // マークを消す．
-  for ( const McRowHead* row1 = row_front();
-	!is_row_end(row1); row1 = row1->next() ) {
-    row1->mWork = 0U;
-  }
+  row_list_array.clear();
+  col_list_array.clear();
+
+  // 同じ行に要素を持つ列を union-find でまとめる．
+  // 再帰を用いないので長い鎖状の行列でもスタックは溢れない．
+  vector<int> parent(col_size());
   for ( const McColHead* col1 = col_front();
 	!is_col_end(col1); col1 = col1->next() ) {
-    col1->mWork = 0U;
+    parent[col1->pos()] = col1->pos();
   }
-
-  // 最初の行から到達可能な行と列にマークをつける．
-  const McRowHead* row0 = row_front();
-  int nc1 = mark_cols(row0);
-
-  int nr = row_num();
-  int nc = col_num();
-
-  if ( nc == nc1 ) {
-    return false;
-  }
-
-  ymuint bitmask = 0U;
-  if ( nc1 > nc - nc1 ) {
-    bitmask = 1U;
+  auto find = [&](int x) {
+    while ( parent[x] != x ) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  };
+  for ( const McRowHead* row1 = row_front();
+	!is_row_end(row1); row1 = row1->next() ) {
+    int root0 = find(row1->front()->col_pos());
+    for ( const McCell* cell = row1->front()->row_next();
+	  !row1->is_end(cell); cell = cell->row_next() ) {
+      int root1 = find(cell->col_pos());
+      if ( root1 != root0 ) {
+	parent[root1] = root0;
+      }
+    }
   }
 
-  row_list1.clear();
-  row_list1.reserve(nr);
-  row_list2.clear();
-  row_list2.reserve(nr);
+  // 代表元ごとにブロック番号を割り振る．
+  // 行は先頭の列の属するブロックに入れる．
+  vector<int> block_id(col_size(), -1);
   for ( const McRowHead* row1 = row_front();
 	!is_row_end(row1); row1 = row1->next() ) {
-    if ( row1->mWork ^ bitmask ) {
-      row_list1.push_back(row1->pos());
-    }
-    else {
-      row_list2.push_back(row1->pos());
+    int root = find(row1->front()->col_pos());
+    if ( block_id[root] == -1 ) {
+      block_id[root] = row_list_array.size();
+      row_list_array.push_back(vector<int>());
     }
+    row_list_array[block_id[root]].push_back(row1->pos());
+  }
+
+  int nb = row_list_array.size();
+  if ( nb <= 1 ) {
+    row_list_array.clear();
+    return false;
   }
 
-  col_list1.clear();
-  col_list1.reserve(nc);
-  col_list2.clear();
-  col_list2.reserve(nc);
+  col_list_array.resize(nb);
   for ( const McColHead* col1 = col_front();
 	!is_col_end(col1); col1 = col1->next() ) {
-    if ( col1->mWork ^ bitmask ) {
-      col_list1.push_back(col1->pos());
-    }
-    else {
-      col_list2.push_back(col1->pos());
-    }
+    int root = find(col1->pos());
+    col_list_array[block_id[root]].push_back(col1->pos());
   }
 
   return true;
 }
 
-// @brief col に接続している行をマークする．
-// @param[in] col 対象の列
-// @return マークされた列数を返す．
-int
-McMatrix::mark_rows(const McColHead* col) const
-{
-  int nc = 0;
-  for ( const McCell* cell = col->front();
-	!col->is_end(cell); cell = cell->col_next() ) {
-    int row_pos = cell->row_pos();
-    const McRowHead* row1 = row(row_pos);
-    if ( row1->mWork == 0U ) {
-      row1->mWork = 1U;
-      nc += mark_cols(row1);
-    }
-  }
-  return nc;
-}
-
-// @brief row に接続している列をマークする．
-// @param[in] row 対象の行
-// @return マークされた列数を返す．
-int
-McMatrix::mark_cols(const McRowHead* row) const
-{
-  int nc = 0;
-  for ( const McCell* cell = row->front();
-	!row->is_end(cell); cell = cell->row_next() ) {
-    int col_pos = cell->col_pos();
-    const McColHead* col1 = col(col_pos);
-    if ( col1->mWork == 0U ) {
-      col1->mWork = 1U;
-      ++ nc;
-      nc += mark_rows(col1);
-    }
-  }
-  return nc;
-}
-
 // @brief 列集合がカバーになっているか検証する．
 // @param[in] col_list 列のリスト
 // @retval true col_list がカバーになっている．
@@ -543,23 +561,20 @@ McMatrix::mark_cols(const McRowHead* row) const
 bool
 McMatrix::verify(const vector<int>& col_list) const
 {
-  for ( const McRowHead* row1 = row_front();
-	!is_row_end(row1); row1 = row1->next() ) {
-    row1->mWork = 0U;
-  }
-  for ( int i = 0; i < col_list.size(); ++ i ) {
+  McMark row_mark(row_size());
+  for ( int i = 0; i < static_cast<int>(col_list.size()); ++ i ) {
     int col_pos = col_list[i];
     const McColHead* col1 = col(col_pos);
     for ( const McCell* cell = col1->front();
 	  !col1->is_end(cell); cell = cell->col_next() ) {
       int row_pos = cell->row_pos();
-      row(row_pos)->mWork = 1U;
+      row_mark.set(row_pos);
     }
   }
   bool status = true;
   for ( const McRowHead* row1 = row_front();
 	!is_row_end(row1); row1 = row1->next() ) {
-    if ( row1->mWork == 0U ) {
+    if ( !row_mark.check(row1->pos()) ) {
       status = false;
     }
   }
@@ -642,9 +657,124 @@ McMatrix::insert_elem(int row_pos,
     ++ mColNum;
   }
 
+  set_row_dirty(row1);
+  set_col_dirty(col1);
+
   return cell;
 }
 
+// @brief CSR 形式のデータから要素をまとめて設定する．
+// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは row_size() + 1 )
+// @param[in] col_idx 要素の列番号の配列 ( サイズは row_ptr[row_size()] )
+void
+McMatrix::load_csr(const vector<int>& row_ptr,
+		   const vector<int>& col_idx)
+{
+  ASSERT_COND( row_num() == 0 && col_num() == 0 );
+  ASSERT_COND( static_cast<int>(row_ptr.size()) == row_size() + 1 );
+  ASSERT_COND( row_ptr[row_size()] == static_cast<int>(col_idx.size()) );
+
+  reserve_cell(col_idx.size());
+
+  // 行番号の昇順に処理するので，セルは常に各列の末尾に追加すればよい．
+  // 行の先頭をつなぐリストも同様に末尾に追加するだけでよい．
+  vector<int> buff;
+  McRowHead* prev_row = &mRowHead;
+  for ( int row_pos = 0; row_pos < row_size(); ++ row_pos ) {
+    int begin = row_ptr[row_pos];
+    int end = row_ptr[row_pos + 1];
+    ASSERT_COND( begin <= end );
+    if ( begin == end ) {
+      continue;
+    }
+
+    // 行内の列番号を昇順に並べて重複を取り除く．
+    buff.assign(col_idx.begin() + begin, col_idx.begin() + end);
+    if ( !is_sorted(buff.begin(), buff.end()) ) {
+      sort(buff.begin(), buff.end());
+    }
+    buff.erase(unique(buff.begin(), buff.end()), buff.end());
+
+    McRowHead* row1 = row(row_pos);
+    McCell* prev_cell = row1->mDummy;
+    for ( auto col_pos: buff ) {
+      ASSERT_COND( col_pos >= 0 && col_pos < col_size() );
+
+      McCell* cell = alloc_cell();
+      cell->mRowPos = row_pos;
+      cell->mColPos = col_pos;
+
+      prev_cell->set_right(cell);
+      cell->set_left(prev_cell);
+      prev_cell = cell;
+      row1->mSig |= McCell::sig_bit(col_pos);
+
+      McColHead* col1 = col(col_pos);
+      McCell* tail = col1->mDummy->up();
+      tail->set_down(cell);
+      cell->set_up(tail);
+      cell->set_down(col1->mDummy);
+      col1->mDummy->set_up(cell);
+      ++ col1->mNum;
+      col1->mSig |= McCell::sig_bit(row_pos);
+    }
+    prev_cell->set_right(row1->mDummy);
+    row1->mDummy->set_left(prev_cell);
+    row1->mNum = buff.size();
+
+    prev_row->mNext = row1;
+    row1->mPrev = prev_row;
+    prev_row = row1;
+    ++ mRowNum;
+    set_row_dirty(row1);
+  }
+  prev_row->mNext = &mRowHead;
+  mRowHead.mPrev = prev_row;
+
+  McColHead* prev_col = &mColHead;
+  for ( int col_pos = 0; col_pos < col_size(); ++ col_pos ) {
+    McColHead* col1 = col(col_pos);
+    if ( col1->num() == 0 ) {
+      continue;
+    }
+    prev_col->mNext = col1;
+    col1->mPrev = prev_col;
+    prev_col = col1;
+    ++ mColNum;
+    set_col_dirty(col1);
+  }
+  prev_col->mNext = &mColHead;
+  mColHead.mPrev = prev_col;
+}
+
+// @brief COO 形式のデータから要素をまとめて設定する．
+// @param[in] row_idx 要素の行番号の配列
+// @param[in] col_idx 要素の列番号の配列 ( サイズは row_idx と同じ )
+void
+McMatrix::load_coo(const vector<int>& row_idx,
+		   const vector<int>& col_idx)
+{
+  ASSERT_COND( row_idx.size() == col_idx.size() );
+
+  // 行番号ごとの要素数を数えて CSR 形式に変換する．
+  int n = row_idx.size();
+  vector<int> row_ptr(row_size() + 1, 0);
+  for ( auto row_pos: row_idx ) {
+    ASSERT_COND( row_pos >= 0 && row_pos < row_size() );
+    ++ row_ptr[row_pos + 1];
+  }
+  for ( int i = 0; i < row_size(); ++ i ) {
+    row_ptr[i + 1] += row_ptr[i];
+  }
+  vector<int> wpos(row_ptr.begin(), row_ptr.end() - 1);
+  vector<int> csr_col_idx(n);
+  for ( int i = 0; i < n; ++ i ) {
+    csr_col_idx[wpos[row_idx[i]] ++] = col_idx[i];
+  }
+
+  load_csr(row_ptr, csr_col_idx);
+}
+
 // @brief 列を選択し，被覆される行を削除する．
 void
 McMatrix::select_col(int col_pos)
@@ -664,11 +794,73 @@ McMatrix::select_col(int col_pos)
   }
 }
 
+// @brief リスナを登録する．
+// @param[in] listener 登録するリスナ
+void
+McMatrix::add_listener(McMatrixListener* listener)
+{
+  mListenerList.push_back(listener);
+}
+
+// @brief リスナの登録を取り消す．
+// @param[in] listener 取り消すリスナ
+void
+McMatrix::remove_listener(McMatrixListener* listener)
+{
+  auto p = find(mListenerList.begin(), mListenerList.end(), listener);
+  if ( p != mListenerList.end() ) {
+    mListenerList.erase(p);
+  }
+}
+
+// @brief 行の衝突グラフを作る．
+void
+McMatrix::make_conflict_graph()
+{
+  if ( mConflictGraph == nullptr ) {
+    mConflictGraph = new McConflictGraph(*this);
+    add_listener(mConflictGraph);
+  }
+}
+
+// @brief column splitting の行の重みを作る．
+void
+McMatrix::make_row_weight()
+{
+  if ( mRowWeight == nullptr ) {
+    mRowWeight = new McRowWeight(*this);
+    add_listener(mRowWeight);
+  }
+}
+
+// @brief SelSimple の列の評価値を作る．
+void
+McMatrix::make_col_score()
+{
+  if ( mColScore == nullptr ) {
+    mColScore = new McColScore(*this);
+    add_listener(mColScore);
+  }
+}
+
+// @brief SelSimple の列の評価値を取り除く．
+void
+McMatrix::delete_col_score()
+{
+  if ( mColScore != nullptr ) {
+    remove_listener(mColScore);
+    delete mColScore;
+    mColScore = nullptr;
+  }
+}
+
 // @brief 削除スタックにマーカーを書き込む．
 void
 McMatrix::save()
 {
   push_marker();
+  mDirtyStack.push_back(mDirtyRowList);
+  mDirtyStack.push_back(mDirtyColList);
 }
 
 // @brief 直前のマーカーまで処理を戻す．
@@ -691,6 +883,35 @@ McMatrix::restore()
       restore_row(row_pos);
     }
   }
+
+  // reduce() で調べ直す行と列も save() の時点に戻す．
+  if ( !mDirtyStack.empty() ) {
+    clear_dirty();
+    mDirtyColList.swap(mDirtyStack.back());
+    mDirtyStack.pop_back();
+    mDirtyRowList.swap(mDirtyStack.back());
+    mDirtyStack.pop_back();
+    for ( auto row_pos: mDirtyRowList ) {
+      row(row_pos)->mDirty = true;
+    }
+    for ( auto col_pos: mDirtyColList ) {
+      col(col_pos)->mDirty = true;
+    }
+  }
+}
+
+// @brief reduce() で調べ直す行と列のリストをクリアする．
+void
+McMatrix::clear_dirty()
+{
+  for ( auto row_pos: mDirtyRowList ) {
+    row(row_pos)->mDirty = false;
+  }
+  mDirtyRowList.clear();
+  for ( auto col_pos: mDirtyColList ) {
+    col(col_pos)->mDirty = false;
+  }
+  mDirtyColList.clear();
 }
 
 // @brief 行を削除する．
@@ -709,17 +930,22 @@ McMatrix::delete_row(int row_pos)
   prev->mNext = next;
   next->mPrev = prev;
 
-  for ( McCell* cell = row1->mDummy.mRightLink;
-	!row1->is_end(cell); cell = cell->mRightLink ) {
+  for ( McCell* cell = row1->mDummy->right();
+	!row1->is_end(cell); cell = cell->right() ) {
     int col_pos = cell->col_pos();
     McColHead* col1 = col(col_pos);
     col1->delete_elem(cell);
+    set_col_dirty(col1);
     if ( col1->num() == 0 ) {
       delete_col(col_pos);
     }
   }
 
   push_row(row_pos);
+
+  for ( auto listener: mListenerList ) {
+    listener->row_deleted(*this, row_pos);
+  }
 }
 
 // @brief 行を復元する．
@@ -729,6 +955,10 @@ McMatrix::restore_row(int row_pos)
   McRowHead* row1 = row(row_pos);
   ASSERT_COND( row1->mDeleted );
 
+  for ( auto listener: mListenerList ) {
+    listener->row_restored(*this, row_pos);
+  }
+
   row1->mDeleted = false;
   ++ mRowNum;
 
@@ -737,8 +967,8 @@ McMatrix::restore_row(int row_pos)
   prev->mNext = row1;
   next->mPrev = row1;
 
-  for ( McCell* cell = row1->mDummy.mRightLink;
-	!row1->is_end(cell); cell = cell->mRightLink ) {
+  for ( McCell* cell = row1->mDummy->right();
+	!row1->is_end(cell); cell = cell->right() ) {
     McColHead* col1 = col(cell->col_pos());
     col1->insert_elem(cell);
   }
@@ -760,17 +990,22 @@ McMatrix::delete_col(int col_pos)
   prev->mNext = next;
   next->mPrev = prev;
 
-  for ( McCell* cell = col1->mDummy.mDownLink;
-	!col1->is_end(cell); cell = cell->mDownLink ) {
+  for ( McCell* cell = col1->mDummy->down();
+	!col1->is_end(cell); cell = cell->down() ) {
     int row_pos = cell->row_pos();
     McRowHead* row1 = row(row_pos);
     row1->delete_elem(cell);
+    set_row_dirty(row1);
     if ( row1->num() == 0 ) {
       delete_row(row_pos);
     }
   }
 
   push_col(col_pos);
+
+  for ( auto listener: mListenerList ) {
+    listener->col_deleted(*this, col_pos);
+  }
 }
 
 // @brief 列を復元する．
@@ -780,6 +1015,10 @@ McMatrix::restore_col(int col_pos)
   McColHead* col1 = col(col_pos);
   ASSERT_COND( col1->mDeleted );
 
+  for ( auto listener: mListenerList ) {
+    listener->col_restored(*this, col_pos);
+  }
+
   col1->mDeleted = false;
   ++ mColNum;
 
@@ -788,8 +1027,8 @@ McMatrix::restore_col(int col_pos)
   prev->mNext = col1;
   next->mPrev = col1;
 
-  for ( McCell* cell = col1->mDummy.mDownLink;
-	!col1->is_end(cell); cell = cell->mDownLink ) {
+  for ( McCell* cell = col1->mDummy->down();
+	!col1->is_end(cell); cell = cell->down() ) {
     McRowHead* row1 = row(cell->row_pos());
     row1->insert_elem(cell);
   }
@@ -797,57 +1036,56 @@ McMatrix::restore_col(int col_pos)
 
 // @brief 簡単化を行う．
 // @param[out] selected_cols 簡単化中で選択された列の集合
+// @param[in] option オプション
 void
-McMatrix::reduce(vector<int>& selected_cols)
+McMatrix::reduce(vector<int>& selected_cols,
+		 const McOption& option)
 {
-  if ( mcmatrix_debug > 0 ) {
+  if ( option.mMatrixDebug > 0 ) {
     cout << "McMatrix::reduce(): " << _remain_row_size() << " x " << _remain_col_size() << endl;
   }
 
-  int no_change = 0;
-  for ( ; ; ) {
+  // 調べ直す行と列がなくなるまで繰り返す．
+  while ( !mDirtyRowList.empty() || !mDirtyColList.empty() ) {
     // 列支配を探し，列の削除を行う．
-    if ( col_dominance() ) {
-      no_change = 0;
-      if ( mcmatrix_debug > 0 ) {
+    if ( col_dominance(option) ) {
+      if ( option.mMatrixDebug > 0 ) {
 	cout << " after col_dominance: " << _remain_row_size() << " x " << _remain_col_size() << endl;
       }
     }
-    else {
-      ++ no_change;
-      if ( no_change >= 3 ) {
-	break;
-      }
-    }
 
     // 必須列を探し，列の選択を行う．
-    if ( essential_col(selected_cols) ) {
-      no_change = 0;
-      if ( mcmatrix_debug > 0 ) {
+    if ( essential_col(selected_cols, option) ) {
+      if ( option.mMatrixDebug > 0 ) {
 	cout << " after essential_col: " << _remain_row_size() << " x " << _remain_col_size() << endl;
       }
     }
-    else {
-      ++ no_change;
-      if ( no_change >= 3 ) {
-	break;
-      }
-    }
 
     // 行支配を探し，行の削除を行う．
-    if ( row_dominance() ) {
-      no_change = 0;
-      if ( mcmatrix_debug > 0 ) {
+    if ( row_dominance(option) ) {
+      if ( option.mMatrixDebug > 0 ) {
 	cout << " after row_dominance: " << _remain_row_size() << " x " << _remain_col_size() << endl;
       }
     }
-    else {
-      ++ no_change;
-      if ( no_change >= 3 ) {
-	break;
-      }
+  }
+
+#if defined(VERIFY_MINCOV)
+  // 支配されている行や列が残っていないかチェックする．
+  vector<int> tmp_list;
+  for ( const McRowHead* row1 = row_front();
+	!is_row_end(row1); row1 = row1->next() ) {
+    ASSERT_COND( row1->num() > 1 );
+    find_dominated_rows(row1, tmp_list);
+    ASSERT_COND( tmp_list.empty() );
+  }
+  for ( const McColHead* col1 = col_front();
+	!is_col_end(col1); col1 = col1->next() ) {
+    if ( col1->num() > 0 ) {
+      ymuint64 sig1;
+      ASSERT_COND( find_dominating_col(col1, sig1) == nullptr );
     }
   }
+#endif
 }
 
 
@@ -863,96 +1101,183 @@ struct RowLt
   }
 };
 
+// 並列に処理する最小の候補数
+// これより少ない時は並列化のオーバーヘッドの方が大きい．
+const int PARALLEL_MIN_NUM = 4096;
+
+// item_num 個の要素を thread_num 個のスレッドで分割して
+// func(begin, end, id) を実行する．
+template <typename Func>
+void
+parallel_for(int item_num,
+	     int thread_num,
+	     Func func)
+{
+  vector<std::thread> thread_list;
+  thread_list.reserve(thread_num);
+  for ( int i = 0; i < thread_num; ++ i ) {
+    int begin = static_cast<ymint64>(item_num) * i / thread_num;
+    int end = static_cast<ymint64>(item_num) * (i + 1) / thread_num;
+    thread_list.push_back(std::thread(func, begin, end, i));
+  }
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+}
+
 END_NONAMESPACE
 
 
 // @brief 行支配を探し，行を削除する．
+// @param[in] option オプション
 // @return 削除された行があったら true を返す．
 bool
-McMatrix::row_dominance()
+McMatrix::row_dominance(const McOption& option)
 {
   bool change = false;
 
-  // 行のマークをクリアする．
-  for ( const McRowHead* row1 = row_front();
-	!is_row_end(row1); row1 = row1->next() ) {
-    row1->mWork = 0;
+  // 要素の削除された行が新たに他の行を支配している可能性がある．
+  vector<int> row_list;
+  row_list.swap(mDirtyRowList);
+  for ( auto row_pos: row_list ) {
+    row(row_pos)->mDirty = false;
   }
 
-  for ( const McRowHead* row1 = row_front();
-	!is_row_end(row1); row1 = row1->next() ) {
-    if ( row1->mWork ) continue;
-
-    // row1 の行に要素を持つ列で要素数が最小のものを求める．
-    int min_num = row_size() + 1;
-    const McColHead* min_col = nullptr;
-    for ( const McCell* cell = row1->front();
-	  !row1->is_end(cell); cell = cell->row_next() ) {
-      int col_pos = cell->col_pos();
-      const McColHead* col1 = col(col_pos);
-      int col_num = col1->num();
-      if ( min_num > col_num ) {
-	min_num = col_num;
-	min_col = col1;
-      }
+  // 支配関係にある (支配されている行, 支配している行) のリスト
+  vector<std::pair<int, int>> pair_list;
+  if ( option.mThreadNum > 1 && row_list.size() >= PARALLEL_MIN_NUM ) {
+    // 各スレッドは行列を読むだけで支配関係の検出のみを行う．
+    // シグネチャの更新も行わない．
+    vector<vector<std::pair<int, int>>> pair_list_array(option.mThreadNum);
+    parallel_for(row_list.size(), option.mThreadNum,
+		 [&](int begin, int end, int id) {
+		   vector<int> tmp_list;
+		   for ( int i = begin; i < end; ++ i ) {
+		     const McRowHead* row1 = row(row_list[i]);
+		     if ( row1->mDeleted ) continue;
+		     tmp_list.clear();
+		     find_dominated_rows(row1, tmp_list);
+		     for ( auto row_pos2: tmp_list ) {
+		       pair_list_array[id].push_back(std::make_pair(row_pos2, row1->pos()));
+		     }
+		   }
+		 });
+    for ( auto& tmp_list: pair_list_array ) {
+      pair_list.insert(pair_list.end(), tmp_list.begin(), tmp_list.end());
     }
-    // min_col に要素を持つ行のうち row1 に支配されている行を求める．
-    for ( const McCell* cell = min_col->front();
-	  !min_col->is_end(cell); cell = cell->col_next() ) {
-      const McRowHead* row2 = row(cell->row_pos());
-      if ( row2 == row1 ) {
-	// 自分自身は比較しない．
-	continue;
-      }
-      if ( row2->num() < row1->num() ) {
-	// 要素数が少ない行も比較しない．
-	continue;
-      }
-      if ( row2->mWork ) {
-	// 削除された行も比較しない.
-	continue;
+  }
+  else {
+    vector<int> tmp_list;
+    for ( auto row_pos1: row_list ) {
+      McRowHead* row1 = row(row_pos1);
+      if ( row1->mDeleted ) continue;
+      tmp_list.clear();
+      row1->mSig = find_dominated_rows(row1, tmp_list);
+      for ( auto row_pos2: tmp_list ) {
+	pair_list.push_back(std::make_pair(row_pos2, row_pos1));
       }
+    }
+  }
 
-      // row1 が row2 を支配しているか調べる．
-      const McCell* cell1 = row1->front();
-      int pos1 = cell1->col_pos();
-      const McCell* cell2 = row2->front();
-      int pos2 = cell2->col_pos();
-      bool found = false;
-      for ( ; ; ) {
-	if ( pos1 < pos2 ) {
-	  // row1 に含まれていて row2 に含まれていない列があるので
-	  // row1 は row2 を支配しない．
-	  break;
-	}
-	else if ( pos1 == pos2 ) {
-	  cell1 = cell1->row_next();
-	  if ( row1->is_end(cell1) ) {
-	    found = true;
-	    break;
-	  }
-	  pos1 = cell1->col_pos();
-	}
-	cell2 = cell2->row_next();
-	if ( row2->is_end(cell2) ) {
+  // 実際の削除は検出された順に直列に行う．
+  // 行の削除で空になるのは他の行を含まない列だけなので
+  // 削除されていない行どうしの支配関係は変わらない．
+  for ( auto& p: pair_list ) {
+    int row_pos2 = p.first;
+    int row_pos1 = p.second;
+    if ( row(row_pos1)->mDeleted || row(row_pos2)->mDeleted ) {
+      continue;
+    }
+    delete_row(row_pos2);
+    change = true;
+    if ( option.mMatrixDebug > 1 ) {
+      cout << "Row#" << row_pos2 << " is dominated by Row#" << row_pos1 << endl;
+    }
+  }
+
+  return change;
+}
+
+// @brief row1 が支配している行を求める．
+// @param[in] row1 対象の行
+// @param[out] row_list row1 に支配されている行番号を追加するリスト
+// @return row1 の正確なシグネチャを返す．
+ymuint64
+McMatrix::find_dominated_rows(const McRowHead* row1,
+			      vector<int>& row_list) const
+{
+  // row1 の行に要素を持つ列で要素数が最小のものを求める．
+  // ついでに row1 の正確なシグネチャを求めておく．
+  int min_num = row_size() + 1;
+  const McColHead* min_col = nullptr;
+  ymuint64 sig1 = 0ULL;
+  for ( const McCell* cell = row1->front();
+	!row1->is_end(cell); cell = cell->row_next() ) {
+    int col_pos = cell->col_pos();
+    const McColHead* col1 = col(col_pos);
+    int col_num = col1->num();
+    if ( min_num > col_num ) {
+      min_num = col_num;
+      min_col = col1;
+    }
+    sig1 |= McCell::sig_bit(col_pos);
+  }
+
+  // min_col に要素を持つ行のうち row1 に支配されている行を求める．
+  for ( const McCell* cell = min_col->front();
+	!min_col->is_end(cell); cell = cell->col_next() ) {
+    const McRowHead* row2 = row(cell->row_pos());
+    if ( row2 == row1 ) {
+      // 自分自身は比較しない．
+      continue;
+    }
+    if ( row2->num() < row1->num() ) {
+      // 要素数が少ない行も比較しない．
+      continue;
+    }
+    if ( row2->mDeleted ) {
+      // 削除された行も比較しない.
+      continue;
+    }
+    if ( (sig1 & ~row2->mSig) != 0ULL ) {
+      // row2 のシグネチャは実際の列集合を包含しているので
+      // row1 にのみ含まれるビットがあれば支配していない．
+      continue;
+    }
+
+    // row1 が row2 を支配しているか調べる．
+    const McCell* cell1 = row1->front();
+    int pos1 = cell1->col_pos();
+    const McCell* cell2 = row2->front();
+    int pos2 = cell2->col_pos();
+    bool found = false;
+    for ( ; ; ) {
+      if ( pos1 < pos2 ) {
+	// row1 に含まれていて row2 に含まれていない列があるので
+	// row1 は row2 を支配しない．
+	break;
+      }
+      else if ( pos1 == pos2 ) {
+	cell1 = cell1->row_next();
+	if ( row1->is_end(cell1) ) {
+	  found = true;
 	  break;
 	}
-	pos2 = cell2->col_pos();
+	pos1 = cell1->col_pos();
       }
-      if ( found ) {
-	// row1 は row2 を支配している．
-	int row_pos = row2->pos();
-	delete_row(row_pos);
-	row2->mWork = 1;
-	change = true;
-	if ( mcmatrix_debug > 1 ) {
-	  cout << "Row#" << row_pos << " is dominated by Row#" << row1->pos() << endl;
-	}
+      cell2 = cell2->row_next();
+      if ( row2->is_end(cell2) ) {
+	break;
       }
+      pos2 = cell2->col_pos();
+    }
+    if ( found ) {
+      // row1 は row2 を支配している．
+      row_list.push_back(row2->pos());
     }
   }
 
-  return change;
+  return sig1;
 }
 
 
@@ -972,123 +1297,191 @@ END_NONAMESPACE
 
 
 // @brief 列支配を探し，列を削除する．
+// @param[in] option オプション
 // @return 削除された列があったら true を返す．
 bool
-McMatrix::col_dominance()
+McMatrix::col_dominance(const McOption& option)
 {
   bool change = false;
 
-  for ( const McColHead* col1 = col_front();
-	!is_col_end(col1); col1 = col1->next() ) {
-    if ( col1->num() == 0 ) continue;
+  // 要素の削除された列が新たに他の列に支配されている可能性がある．
+  vector<int> col_list;
+  col_list.swap(mDirtyColList);
+  for ( auto col_pos: col_list ) {
+    col(col_pos)->mDirty = false;
+  }
 
-    // col1 の列に要素を持つ行で要素数が最小のものを求める．
-    int min_num = col_size() + 1;
-    const McRowHead* min_row = nullptr;
-    for ( const McCell* cell = col1->front();
-	  !col1->is_end(cell); cell = cell->col_next() ) {
-      int row_pos = cell->row_pos();
-      const McRowHead* row1 = row(row_pos);
-      int row_num = row1->num();
-      if ( min_num > row_num ) {
-	min_num = row_num;
-	min_row = row1;
+  // 支配関係にある (支配されている列, 支配している列) のリスト
+  vector<std::pair<int, int>> pair_list;
+  if ( option.mThreadNum > 1 && col_list.size() >= PARALLEL_MIN_NUM ) {
+    // 各スレッドは行列を読むだけで支配関係の検出のみを行う．
+    // シグネチャの更新も行わない．
+    vector<vector<std::pair<int, int>>> pair_list_array(option.mThreadNum);
+    parallel_for(col_list.size(), option.mThreadNum,
+		 [&](int begin, int end, int id) {
+		   for ( int i = begin; i < end; ++ i ) {
+		     const McColHead* col1 = col(col_list[i]);
+		     if ( col1->mDeleted || col1->num() == 0 ) continue;
+		     ymuint64 sig1;
+		     const McColHead* col2 = find_dominating_col(col1, sig1);
+		     if ( col2 != nullptr ) {
+		       pair_list_array[id].push_back(std::make_pair(col1->pos(), col2->pos()));
+		     }
+		   }
+		 });
+    for ( auto& tmp_list: pair_list_array ) {
+      pair_list.insert(pair_list.end(), tmp_list.begin(), tmp_list.end());
+    }
+  }
+  else {
+    for ( auto col_pos1: col_list ) {
+      McColHead* col1 = col(col_pos1);
+      if ( col1->mDeleted || col1->num() == 0 ) continue;
+      const McColHead* col2 = find_dominating_col(col1, col1->mSig);
+      if ( col2 != nullptr ) {
+	pair_list.push_back(std::make_pair(col_pos1, col2->pos()));
       }
     }
+  }
 
-    // min_row の行に要素を持つ列を対象にして支配関係のチェックを行う．
-    for ( const McCell* cell = min_row->front();
-	  !min_row->is_end(cell); cell = cell->row_next() ) {
-      const McColHead* col2 = col(cell->col_pos());
-      if ( col2 == col1 ) {
-	// 自分自身は比較しない．
-	continue;
-      }
-      if ( col2->num() < col1->num() ) {
-	// ただし col1 よりも要素数の少ない列は調べる必要はない．
-	continue;
-      }
-      if ( col_cost(col2->pos()) > col_cost(col1->pos()) ) {
-	// col2 のコストが col のコストより高ければ調べる必要はない．
+  // 実際の削除は検出された順に直列に行う．
+  // 列の削除で行は変わらないので削除されていない列どうしの
+  // 支配関係は変わらないが，支配している列の方が先に削除された時は
+  // 支配されている列を支配する別の列を探し直す必要がある．
+  for ( auto& p: pair_list ) {
+    int col_pos1 = p.first;
+    int col_pos2 = p.second;
+    McColHead* col1 = col(col_pos1);
+    if ( col1->mDeleted ) {
+      continue;
+    }
+    if ( col(col_pos2)->mDeleted ) {
+      const McColHead* col2 = find_dominating_col(col1, col1->mSig);
+      if ( col2 == nullptr ) {
 	continue;
       }
+      col_pos2 = col2->pos();
+    }
+    delete_col(col_pos1);
+    change = true;
+    if ( option.mMatrixDebug > 1 ) {
+      cout << "Col#" << col_pos1 << " is dominated by Col#"
+	   << col_pos2 << endl;
+    }
+  }
 
-      const McCell* cell1 = col1->front();
-      int pos1 = cell1->row_pos();
-      const McCell* cell2 = col2->front();
-      int pos2 = cell2->row_pos();
-      bool found = false;
-      for ( ; ; ) {
-	if ( pos1 < pos2 ) {
-	  // col1 に含まれていて col2 に含まれない行があるので
-	  // col2 は col1 を支配しない．
-	  break;
-	}
-	if ( pos1 == pos2 ) {
-	  cell1 = cell1->col_next();
-	  if ( col1->is_end(cell1) ) {
-	    found = true;
-	    break;
-	  }
-	  pos1 = cell1->row_pos();
-	}
-	cell2 = cell2->col_next();
-	if ( col2->is_end(cell2) ) {
+  return change;
+}
+
+// @brief col1 を支配している列を求める．
+// @param[in] col1 対象の列
+// @param[out] sig1 col1 の正確なシグネチャ
+// @return col1 を支配している列を返す．
+//
+// 見つからなければ nullptr を返す．
+const McColHead*
+McMatrix::find_dominating_col(const McColHead* col1,
+			      ymuint64& sig1) const
+{
+  // col1 の列に要素を持つ行で要素数が最小のものを求める．
+  // ついでに col1 の正確なシグネチャを求めておく．
+  int min_num = col_size() + 1;
+  const McRowHead* min_row = nullptr;
+  sig1 = 0ULL;
+  for ( const McCell* cell = col1->front();
+	!col1->is_end(cell); cell = cell->col_next() ) {
+    int row_pos = cell->row_pos();
+    const McRowHead* row1 = row(row_pos);
+    int row_num = row1->num();
+    if ( min_num > row_num ) {
+      min_num = row_num;
+      min_row = row1;
+    }
+    sig1 |= McCell::sig_bit(row_pos);
+  }
+
+  // min_row の行に要素を持つ列を対象にして支配関係のチェックを行う．
+  for ( const McCell* cell = min_row->front();
+	!min_row->is_end(cell); cell = cell->row_next() ) {
+    const McColHead* col2 = col(cell->col_pos());
+    if ( col2 == col1 ) {
+      // 自分自身は比較しない．
+      continue;
+    }
+    if ( col2->num() < col1->num() ) {
+      // ただし col1 よりも要素数の少ない列は調べる必要はない．
+      continue;
+    }
+    if ( col_cost(col2->pos()) > col_cost(col1->pos()) ) {
+      // col2 のコストが col のコストより高ければ調べる必要はない．
+      continue;
+    }
+    if ( (sig1 & ~col2->mSig) != 0ULL ) {
+      // col2 のシグネチャは実際の行集合を包含しているので
+      // col1 にのみ含まれるビットがあれば支配されていない．
+      continue;
+    }
+
+    const McCell* cell1 = col1->front();
+    int pos1 = cell1->row_pos();
+    const McCell* cell2 = col2->front();
+    int pos2 = cell2->row_pos();
+    bool found = false;
+    for ( ; ; ) {
+      if ( pos1 < pos2 ) {
+	// col1 に含まれていて col2 に含まれない行があるので
+	// col2 は col1 を支配しない．
+	break;
+      }
+      if ( pos1 == pos2 ) {
+	cell1 = cell1->col_next();
+	if ( col1->is_end(cell1) ) {
+	  found = true;
 	  break;
 	}
-	pos2 = cell2->row_pos();
+	pos1 = cell1->row_pos();
       }
-      if ( found ) {
-	// col2 は col1 を支配している．
-	delete_col(col1->pos());
-	if ( mcmatrix_debug > 1 ) {
-	  cout << "Col#" << col1->pos() << " is dominated by Col#"
-	       << col2->pos() << endl;
-	}
-	change = true;
+      cell2 = cell2->col_next();
+      if ( col2->is_end(cell2) ) {
 	break;
       }
+      pos2 = cell2->row_pos();
+    }
+    if ( found ) {
+      // col2 は col1 を支配している．
+      return col2;
     }
   }
 
-  return change;
+  return nullptr;
 }
 
 // @brief 必須列を探し，列を選択する．
 // @param[out] selected_cols 選択された列を追加する列集合
+// @param[in] option オプション
 // @return 選択された列があったら true を返す．
 bool
-McMatrix::essential_col(vector<int>& selected_cols)
+McMatrix::essential_col(vector<int>& selected_cols,
+			const McOption& option)
 {
-  // マークをクリアする．
-  for ( const McColHead* col1 = col_front();
-	!is_col_end(col1); col1 = col1->next() ) {
-    col1->mWork = 0;
-  }
-
+  // 要素数が1になりうるのは要素の削除された行だけである．
+  // select_col() で新たに追加された行も調べる．
   int old_size = selected_cols.size();
-  for ( const McRowHead* row1 = row_front();
-	!is_row_end(row1); row1 = row1->next() ) {
-    if ( row1->num() == 1 ) {
+  for ( int i = 0; i < static_cast<int>(mDirtyRowList.size()); ++ i ) {
+    const McRowHead* row1 = row(mDirtyRowList[i]);
+    if ( !row1->mDeleted && row1->num() == 1 ) {
       const McCell* cell = row1->front();
       int col_pos = cell->col_pos();
       ASSERT_COND( !col(col_pos)->mDeleted );
 
-      McColHead* col1 = col(col_pos);
-      if ( col1->mWork == 0 ) {
-	col1->mWork = 1;
-	selected_cols.push_back(col_pos);
-	if ( mcmatrix_debug > 1 ) {
-	  cout << "Col#" << col_pos << " is essential" << endl;
-	}
+      selected_cols.push_back(col_pos);
+      if ( option.mMatrixDebug > 1 ) {
+	cout << "Col#" << col_pos << " is essential" << endl;
       }
+      select_col(col_pos);
     }
   }
   int size = selected_cols.size();
-  for ( int i = old_size; i < size; ++ i) {
-    int col_pos = selected_cols[i];
-    select_col(col_pos);
-  }
 
   return size > old_size;
 }
@@ -1097,15 +1490,49 @@ McMatrix::essential_col(vector<int>& selected_cols)
 McCell*
 McMatrix::alloc_cell()
 {
-  void* p = mCellAlloc.get_memory(sizeof(McCell));
-  return new (p) McCell;
+  if ( mCellNum == mCellSize ) {
+    reserve_cell(mCellSize - row_size() - col_size() + 1);
+  }
+  McCell* cell = &mCellArray[mCellNum];
+  ++ mCellNum;
+  return cell;
 }
 
 // @brief セルの解放
+// @param[in] cell 直前に alloc_cell() で確保したセル
 void
 McMatrix::free_cell(McCell* cell)
 {
-  mCellAlloc.put_memory(sizeof(McCell), cell);
+  ASSERT_COND( cell == &mCellArray[mCellNum - 1] );
+  -- mCellNum;
+}
+
+// @brief セルの配列を確保する．
+// @param[in] num 要素として追加するセル数
+void
+McMatrix::reserve_cell(int num)
+{
+  int req_size = mCellNum + num;
+  if ( req_size <= mCellSize ) {
+    return;
+  }
+
+  // リンクは相対位置で表されているので中身をそのままコピーすればよい．
+  McCell* old_array = mCellArray;
+  mCellSize = req_size;
+  mCellArray = new McCell[mCellSize];
+  for ( int i = 0; i < mCellNum; ++ i ) {
+    mCellArray[i] = old_array[i];
+  }
+  delete [] old_array;
+
+  // ダミーヘッダの位置を更新する．
+  for ( int i = 0; i < row_size(); ++ i ) {
+    mRowArray[i].mDummy = &mCellArray[i];
+  }
+  for ( int i = 0; i < col_size(); ++ i ) {
+    mColArray[i].mDummy = &mCellArray[row_size() + i];
+  }
 }
 
 // @brief 内容を出力する．
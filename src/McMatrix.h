@@ -13,7 +13,7 @@
 
 #include "McRowHead.h"
 #include "McColHead.h"
-#include "ym/UnitAlloc.h"
+#include "McMatrixListener.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -37,6 +37,9 @@ public:
 
   /// @brief コピーコンストラクタ
   /// @param[in] src コピー元のオブジェクト
+  ///
+  /// src が部分的なコピーでなければ削除済みの要素や
+  /// 削除スタックも含めて線形時間で複製する．
   McMatrix(const McMatrix& src);
 
   /// @brief 部分的なコピーコンストラクタ
@@ -140,17 +143,16 @@ public:
   cost(const vector<int>& col_list) const;
 
   /// @brief ブロック分割を行う．
-  /// @param[in] row_list1 1つめのブロックの行番号のリスト
-  /// @param[in] row_list2 2つめのブロックの行番号のリスト
-  /// @param[in] col_list1 1つめのブロックの列番号のリスト
-  /// @param[in] col_list2 2つめのブロックの列番号のリスト
-  /// @retval true ブロック分割が行われた．
+  /// @param[out] row_list_array 各ブロックの行番号のリストの配列
+  /// @param[out] col_list_array 各ブロックの列番号のリストの配列
+  /// @retval true 2つ以上のブロックに分割された．
   /// @retval false ブロック分割が行えなかった．
+  ///
+  /// 列を union-find でまとめて全ての連結成分を一度に求める．
+  /// ブロックは先頭の行番号の順に並び，各リストは昇順に並ぶ．
   bool
-  block_partition(vector<int>& row_list1,
-		  vector<int>& row_list2,
-		  vector<int>& col_list1,
-		  vector<int>& col_list2) const;
+  block_partition(vector<vector<int>>& row_list_array,
+		  vector<vector<int>>& col_list_array) const;
 
   /// @brief 列集合がカバーになっているか検証する．
   /// @param[in] col_list 列のリスト
@@ -159,6 +161,25 @@ public:
   bool
   verify(const vector<int>& col_list) const;
 
+  /// @brief 行の衝突グラフを返す．
+  ///
+  /// make_conflict_graph() を呼んでいなければ nullptr を返す．
+  const McConflictGraph*
+  conflict_graph() const;
+
+  /// @brief column splitting の行の重みを返す．
+  ///
+  /// make_row_weight() を呼んでいなければ nullptr を返す．
+  const McRowWeight*
+  row_weight() const;
+
+  /// @brief SelSimple の列の評価値を返す．
+  ///
+  /// make_col_score() を呼んでいなければ nullptr を返す．
+  /// 最大の列を求める時にヒープを直すので const にはしない．
+  McColScore*
+  col_score() const;
+
   /// @brief 内容を出力する．
   /// @param[in] s 出力先のストリーム
   void
@@ -172,13 +193,15 @@ public:
 
   /// @brief 内容をクリアする．
   /// @note 行/列のサイズは不変
+  ///
+  /// 登録されているリスナと衝突グラフも取り除かれる．
   void
   clear();
 
   /// @brief 分割した行列をもとに戻す．
+  /// @param[in] matrix_list 部分的なコピーコンストラクタで作られた行列のリスト
   void
-  merge(McMatrix& matrix1,
-	McMatrix& matrix2);
+  merge(const vector<McMatrix*>& matrix_list);
 
   /// @brief 要素を追加する．
   /// @param[in] row_pos 追加する要素の行番号
@@ -188,6 +211,29 @@ public:
   insert_elem(int row_pos,
 	      int col_pos);
 
+  /// @brief CSR 形式のデータから要素をまとめて設定する．
+  /// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは row_size() + 1 )
+  /// @param[in] col_idx 要素の列番号の配列 ( サイズは row_ptr[row_size()] )
+  ///
+  /// - 空の行列に対して用いる．
+  /// - 同一行内の列番号の順序は任意で，重複は無視される．
+  /// - insert_elem() を繰り返し呼ぶのと同じ結果になるが，
+  ///   各行のソート以外は線形時間で処理される．
+  void
+  load_csr(const vector<int>& row_ptr,
+	   const vector<int>& col_idx);
+
+  /// @brief COO 形式のデータから要素をまとめて設定する．
+  /// @param[in] row_idx 要素の行番号の配列
+  /// @param[in] col_idx 要素の列番号の配列 ( サイズは row_idx と同じ )
+  ///
+  /// - 空の行列に対して用いる．
+  /// - 要素の順序は任意で，重複は無視される．
+  /// - 行番号でバケットソートしてから load_csr() を呼ぶ．
+  void
+  load_coo(const vector<int>& row_idx,
+	   const vector<int>& col_idx);
+
   /// @brief 列を選択し，被覆される行を削除する．
   /// @param[in] col_pos 選択した列
   void
@@ -203,24 +249,87 @@ public:
 
   /// @brief 簡単化を行う．
   /// @param[out] selected_cols 簡単化中で選択された列の集合を追加する配列
+  /// @param[in] option オプション
+  ///
+  /// 前回の簡単化以降に要素の削除された行と列(とその近傍)のみを調べる．
   void
-  reduce(vector<int>& selected_cols);
+  reduce(vector<int>& selected_cols,
+	 const McOption& option);
 
   /// @brief 行支配を探し，行を削除する．
+  /// @param[in] option オプション
   /// @return 削除された行があったら true を返す．
+  ///
+  /// 要素の削除された行を支配する側の候補として調べる．
+  /// option.mThreadNum が 2 以上で候補が多い時は
+  /// 支配関係の検出を並列に行う．
+  /// 削除は常に直列に行うので削除スタックの内容は変わらない．
   bool
-  row_dominance();
+  row_dominance(const McOption& option);
 
   /// @brief 列支配を探し，列を削除する．
+  /// @param[in] option オプション
   /// @return 削除された列があったら true を返す．
+  ///
+  /// 要素の削除された列を支配される側の候補として調べる．
+  /// 並列化については row_dominance() と同様
   bool
-  col_dominance();
+  col_dominance(const McOption& option);
 
   /// @brief 必須列を探し，列を選択する．
   /// @param[out] selected_cols 選択された列を追加する列集合
+  /// @param[in] option オプション
   /// @return 選択された列があったら true を返す．
+  ///
+  /// 要素の削除された行のみを調べる．
   bool
-  essential_col(vector<int>& selected_cols);
+  essential_col(vector<int>& selected_cols,
+		const McOption& option);
+
+  /// @brief リスナを登録する．
+  /// @param[in] listener 登録するリスナ
+  ///
+  /// 以降の行や列の削除/復元が listener に通知される．
+  /// listener の所有権は移らない．
+  /// リスナはコピーされた行列には引き継がれない．
+  void
+  add_listener(McMatrixListener* listener);
+
+  /// @brief リスナの登録を取り消す．
+  /// @param[in] listener 取り消すリスナ
+  void
+  remove_listener(McMatrixListener* listener);
+
+  /// @brief 行の衝突グラフを作る．
+  ///
+  /// 現在の内容から衝突グラフを作り，リスナとして登録する．
+  /// 以降は行や列の削除/復元に合わせて差分だけ更新される．
+  /// すでに作られている場合には何もしない．
+  void
+  make_conflict_graph();
+
+  /// @brief column splitting の行の重みを作る．
+  ///
+  /// 現在の内容から各行の重みを求め，リスナとして登録する．
+  /// 以降は行や列の削除/復元に合わせて値の変わる行だけ更新される．
+  /// すでに作られている場合には何もしない．
+  void
+  make_row_weight();
+
+  /// @brief SelSimple の列の評価値を作る．
+  ///
+  /// 現在の内容から各列の評価値を求め，リスナとして登録する．
+  /// 以降は行や列の削除/復元に合わせて値の変わる列だけ更新される．
+  /// すでに作られている場合には何もしない．
+  void
+  make_col_score();
+
+  /// @brief SelSimple の列の評価値を取り除く．
+  ///
+  /// make_col_score() 以前の削除を restore() で戻す前に呼ぶ．
+  /// 作られていない場合には何もしない．
+  void
+  delete_col_score();
 
   /// @brief 削除スタックにマーカーを書き込む．
   void
@@ -252,22 +361,40 @@ private:
   resize(int row_size,
 	 int col_size);
 
-  /// @brief col に接続している行をマークする．
-  /// @param[in] col 対象の列
-  /// @return マークされた列数を返す．
-  int
-  mark_rows(const McColHead* col) const;
-
-  /// @brief row に接続している列をマークする．
-  /// @param[in] row 対象の行
-  /// @return マークされた列数を返す．
-  int
-  mark_cols(const McRowHead* row) const;
+  /// @brief row1 が支配している行を求める．
+  /// @param[in] row1 対象の行
+  /// @param[out] row_list row1 に支配されている行番号を追加するリスト
+  /// @return row1 の正確なシグネチャを返す．
+  ///
+  /// 行列の内容は変更しないので複数のスレッドから呼んでもよい．
+  ymuint64
+  find_dominated_rows(const McRowHead* row1,
+		      vector<int>& row_list) const;
+
+  /// @brief col1 を支配している列を求める．
+  /// @param[in] col1 対象の列
+  /// @param[out] sig1 col1 の正確なシグネチャ
+  /// @return col1 を支配している列を返す．
+  ///
+  /// 見つからなければ nullptr を返す．
+  /// 行列の内容は変更しないので複数のスレッドから呼んでもよい．
+  const McColHead*
+  find_dominating_col(const McColHead* col1,
+		      ymuint64& sig1) const;
 
   /// @brief 内容をコピーする．
   void
   copy(const McMatrix& src);
 
+  /// @brief 内容をそのまま複製する．
+  /// @param[in] src コピー元のオブジェクト
+  ///
+  /// セルの配列と行/列のヘッダをそのままコピーしてポインタを付け替える．
+  /// 削除済みの要素と削除スタックも複製されるので restore() も使える．
+  /// src は部分的なコピーであってはならない．
+  void
+  clone(const McMatrix& src);
+
   /// @brief 行を復元する．
   void
   restore_row(int row_pos);
@@ -281,9 +408,31 @@ private:
   alloc_cell();
 
   /// @brief セルの解放
+  /// @param[in] cell 直前に alloc_cell() で確保したセル
   void
   free_cell(McCell* cell);
 
+  /// @brief セルの配列を確保する．
+  /// @param[in] num 要素として追加するセル数
+  ///
+  /// 配列が移動した場合には行と列のダミーヘッダのポインタも更新する．
+  void
+  reserve_cell(int num);
+
+  /// @brief 行を reduce() で調べ直す対象にする．
+  /// @param[in] row1 対象の行
+  void
+  set_row_dirty(McRowHead* row1);
+
+  /// @brief 列を reduce() で調べ直す対象にする．
+  /// @param[in] col1 対象の列
+  void
+  set_col_dirty(McColHead* col1);
+
+  /// @brief reduce() で調べ直す行と列のリストをクリアする．
+  void
+  clear_dirty();
+
   /// @brief スタックが空の時 true を返す．
   bool
   stack_empty();
@@ -314,9 +463,6 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // セルを確保するためのアロケータ
-  UnitAlloc mCellAlloc;
-
   // 行数
   int mRowSize;
 
@@ -324,7 +470,8 @@ private:
   int mColSize;
 
   // 行の先頭の配列
-  McRowHead** mRowArray;
+  // サイズは mRowSize で resize() で確保される．
+  McRowHead* mRowArray;
 
   // 行の先頭をつなぐリンクトリストのダミー
   McRowHead mRowHead;
@@ -333,7 +480,8 @@ private:
   int mRowNum;
 
   // 列の先頭の配列
-  McColHead** mColArray;
+  // サイズは mColSize で resize() で確保される．
+  McColHead* mColArray;
 
   // 列の先頭をつなぐリンクトリストのダミー
   McColHead mColHead;
@@ -341,15 +489,54 @@ private:
   // 実際の列数
   int mColNum;
 
+  // セルの配列
+  // 先頭の mRowSize 個は各行のダミーヘッダ，
+  // 次の mColSize 個は各列のダミーヘッダとして用いる．
+  // 部分的なコピーコンストラクタで作られた行列では nullptr となる．
+  McCell* mCellArray;
+
+  // mCellArray のサイズ
+  int mCellSize;
+
+  // mCellArray 中の使用済みの要素数
+  int mCellNum;
+
+  // mRowArray, mColArray を所有している時 true にするフラグ
+  // 部分的なコピーコンストラクタで作られた行列ではコピー元の
+  // mRowArray, mColArray を共有するので false となる．
+  bool mOwnArray;
+
   // コストの配列
   // サイズは mColSize;
   const int* mCostArray;
 
   // 削除の履歴を覚えておくスタック
-  int* mDelStack;
+  vector<int> mDelStack;
+
+  // reduce() で調べ直す行番号のリスト
+  vector<int> mDirtyRowList;
+
+  // reduce() で調べ直す列番号のリスト
+  vector<int> mDirtyColList;
+
+  // save() の時点の mDirtyRowList と mDirtyColList を
+  // この順に積んでおくスタック
+  vector<vector<int>> mDirtyStack;
+
+  // 行や列の削除/復元を通知するリスナのリスト
+  vector<McMatrixListener*> mListenerList;
 
-  // mDelStack のポインタ
-  int mStackTop;
+  // 行の衝突グラフ
+  // make_conflict_graph() で作られる．
+  McConflictGraph* mConflictGraph;
+
+  // column splitting の行の重み
+  // make_row_weight() で作られる．
+  McRowWeight* mRowWeight;
+
+  // SelSimple の列の評価値
+  // make_col_score() で作られる．
+  McColScore* mColScore;
 
 };
 
@@ -380,10 +567,7 @@ inline
 const McRowHead*
 McMatrix::row(int row_pos) const
 {
-  if ( mRowArray[row_pos] == nullptr ) {
-    mRowArray[row_pos] = new McRowHead(row_pos);
-  }
-  return mRowArray[row_pos];
+  return &mRowArray[row_pos];
 }
 
 // @brief 行の先頭を取り出す．
@@ -392,10 +576,7 @@ inline
 McRowHead*
 McMatrix::row(int row_pos)
 {
-  if ( mRowArray[row_pos] == nullptr ) {
-    mRowArray[row_pos] = new McRowHead(row_pos);
-  }
-  return mRowArray[row_pos];
+  return &mRowArray[row_pos];
 }
 
 // @brief 行の先頭を取り出す．
@@ -439,10 +620,7 @@ inline
 const McColHead*
 McMatrix::col(int col_pos) const
 {
-  if ( mColArray[col_pos] == nullptr ) {
-    mColArray[col_pos] = new McColHead(col_pos);
-  }
-  return mColArray[col_pos];
+  return &mColArray[col_pos];
 }
 
 // @brief 列の先頭を取り出す．
@@ -451,10 +629,7 @@ inline
 McColHead*
 McMatrix::col(int col_pos)
 {
-  if ( mColArray[col_pos] == nullptr ) {
-    mColArray[col_pos] = new McColHead(col_pos);
-  }
-  return mColArray[col_pos];
+  return &mColArray[col_pos];
 }
 
 // @brief 列の先頭を取り出す．
@@ -509,12 +684,60 @@ McMatrix::col_cost_array() const
   return mCostArray;
 }
 
+// @brief 行の衝突グラフを返す．
+inline
+const McConflictGraph*
+McMatrix::conflict_graph() const
+{
+  return mConflictGraph;
+}
+
+// @brief column splitting の行の重みを返す．
+inline
+const McRowWeight*
+McMatrix::row_weight() const
+{
+  return mRowWeight;
+}
+
+// @brief SelSimple の列の評価値を返す．
+inline
+McColScore*
+McMatrix::col_score() const
+{
+  return mColScore;
+}
+
+// @brief 行を reduce() で調べ直す対象にする．
+// @param[in] row1 対象の行
+inline
+void
+McMatrix::set_row_dirty(McRowHead* row1)
+{
+  if ( !row1->mDirty ) {
+    row1->mDirty = true;
+    mDirtyRowList.push_back(row1->pos());
+  }
+}
+
+// @brief 列を reduce() で調べ直す対象にする．
+// @param[in] col1 対象の列
+inline
+void
+McMatrix::set_col_dirty(McColHead* col1)
+{
+  if ( !col1->mDirty ) {
+    col1->mDirty = true;
+    mDirtyColList.push_back(col1->pos());
+  }
+}
+
 // @brief スタックが空の時 true を返す．
 inline
 bool
 McMatrix::stack_empty()
 {
-  return mStackTop == 0;
+  return mDelStack.empty();
 }
 
 // @brief スタックに境界マーカーを書き込む．
@@ -546,8 +769,7 @@ inline
 void
 McMatrix::push(int val)
 {
-  mDelStack[mStackTop] = val;
-  ++ mStackTop;
+  mDelStack.push_back(val);
 }
 
 // @brief スタックから取り出す．
@@ -555,8 +777,9 @@ inline
 int
 McMatrix::pop()
 {
-  -- mStackTop;
-  return mDelStack[mStackTop];
+  int val = mDelStack.back();
+  mDelStack.pop_back();
+  return val;
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,81 @@
+﻿#ifndef MCMATRIXLISTENER_H
+#define MCMATRIXLISTENER_H
+
+/// @file McMatrixListener.h
+/// @brief McMatrixListener のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McMatrixListener McMatrixListener.h "McMatrixListener.h"
+/// @brief McMatrix の行や列の削除/復元を受け取るクラス
+///
+/// McMatrix::add_listener() で登録すると，削除スタックに積まれるのと
+/// 同じ順序で row_deleted()/col_deleted() が呼ばれ，
+/// McMatrix::restore() ではその逆順で row_restored()/col_restored() が呼ばれる．
+/// 削除の時点で行列に反映されている変更は，対応する復元の直前まで
+/// そのまま保たれる．
+//////////////////////////////////////////////////////////////////////
+class McMatrixListener
+{
+public:
+
+  /// @brief デストラクタ
+  virtual
+  ~McMatrixListener() { }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] row_pos 行番号
+  virtual
+  void
+  row_deleted(const McMatrix& matrix,
+	      int row_pos) = 0;
+
+  /// @brief 列が削除された．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] col_pos 列番号
+  virtual
+  void
+  col_deleted(const McMatrix& matrix,
+	      int col_pos) = 0;
+
+  /// @brief 行が復元される．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] row_pos 行番号
+  ///
+  /// 行列は row_deleted() の直後と同じ状態になっている．
+  virtual
+  void
+  row_restored(const McMatrix& matrix,
+	       int row_pos) = 0;
+
+  /// @brief 列が復元される．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] col_pos 列番号
+  ///
+  /// 行列は col_deleted() の直後と同じ状態になっている．
+  virtual
+  void
+  col_restored(const McMatrix& matrix,
+	       int col_pos) = 0;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCMATRIXLISTENER_H
@@ -0,0 +1,85 @@
+﻿#ifndef MCOPTION_H
+#define MCOPTION_H
+
+/// @file McOption.h
+/// @brief McOption のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McOption McOption.h "McOption.h"
+/// @brief 最小被覆問題を解く際のオプション
+///
+/// McSolver ごとに持つので，別々の MinCov を異なるスレッドで
+/// 同時に解いても干渉しない．
+//////////////////////////////////////////////////////////////////////
+struct McOption
+{
+
+  /// @brief コンストラクタ
+  ///
+  /// デフォルト値を設定する．
+  McOption();
+
+  // block_partition を行うとき true にするフラグ
+  bool mDoPartition;
+
+  // デバッグフラグ
+  bool mDebug;
+
+  // デバッグで表示する最大深さ
+  int mMaxDepth;
+
+  // 並列処理に用いるスレッド数
+  int mThreadNum;
+
+  // LbMAX で下界を並列に計算する時 true にするフラグ
+  bool mParallelLb;
+
+  // 下界の計算クラスの名前のリスト
+  // 先頭から順に LbMAX に登録される．
+  vector<string> mLbList;
+
+  // LbMIS1/LbMIS2 の局所探索の反復回数
+  // 0 の時は局所探索を行わない．
+  int mMisLsIterNum;
+
+  // McMatrix::reduce() のデバッグレベル
+  int mMatrixDebug;
+
+  // ヒューリスティックのデバッグフラグ
+  bool mHeuristicDebug;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+McOption::McOption() :
+  mDoPartition(true),
+  mDebug(false),
+  mMaxDepth(0),
+  mThreadNum(1),
+  mParallelLb(false),
+  mLbList({"cs", "mis1"}),
+  mMisLsIterNum(0),
+  mMatrixDebug(0),
+  mHeuristicDebug(false)
+{
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCOPTION_H
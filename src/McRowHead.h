@@ -12,7 +12,6 @@
 #include "ym/ym_mincov.h"
 
 #include "McCell.h"
-#include "ym/UnitAlloc.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -28,8 +27,8 @@ class McRowHead
 private:
 
   /// @brief コンストラクタ
-  /// @param[in] pos 行番号
-  McRowHead(int pos);
+  /// @note 実際の値は init() で設定する．
+  McRowHead();
 
   /// @brief デストラクタ
   ~McRowHead();
@@ -71,17 +70,20 @@ public:
   next() const;
 
 
-public:
-
-  mutable
-  int mWork;
-
-
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 初期化する．
+  /// @param[in] pos 行番号
+  /// @param[in] dummy ダミーヘッダとして用いる要素
+  ///
+  /// 接続している要素はクリアされる．
+  void
+  init(int pos,
+       McCell* dummy);
+
   /// @brief 接続している要素をクリアする．
   void
   clear();
@@ -118,7 +120,8 @@ private:
   int mNum;
 
   // 二重連結リストのダミーヘッダ
-  McCell mDummy;
+  // 実体は McMatrix のセルの配列上にある．
+  McCell* mDummy;
 
   // 直前の行を指すリンク
   McRowHead* mPrev;
@@ -129,6 +132,14 @@ private:
   // 削除フラグ
   bool mDeleted;
 
+  // McMatrix::reduce() で調べ直す必要がある時 true にするフラグ
+  bool mDirty;
+
+  // 要素の列番号のシグネチャ
+  // 要素の追加と復元の時に OR するだけなので，削除の後は
+  // 実際のシグネチャを包含する値になっている．
+  ymuint64 mSig;
+
 };
 
 
@@ -137,17 +148,17 @@ private:
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] pos 行番号
 inline
-McRowHead::McRowHead(int pos) :
-  mPos(pos),
+McRowHead::McRowHead() :
+  mPos(0),
   mNum(0),
+  mDummy(nullptr),
   mPrev(nullptr),
   mNext(nullptr),
-  mDeleted(false)
+  mDeleted(false),
+  mDirty(false),
+  mSig(0ULL)
 {
-  mDummy.mLeftLink = &mDummy;
-  mDummy.mRightLink = &mDummy;
 }
 
 /// @brief デストラクタ
@@ -177,7 +188,7 @@ inline
 const McCell*
 McRowHead::front() const
 {
-  return mDummy.mRightLink;
+  return mDummy->right();
 }
 
 // @brief 末尾の要素を返す．
@@ -185,7 +196,7 @@ inline
 const McCell*
 McRowHead::back() const
 {
-  return mDummy.mLeftLink;
+  return mDummy->left();
 }
 
 // @brief cell が終端かどうか調べる．
@@ -195,7 +206,7 @@ inline
 bool
 McRowHead::is_end(const McCell* cell) const
 {
-  return cell == &mDummy;
+  return cell == mDummy;
 }
 
 // @brief 直前の行を返す．
@@ -214,13 +225,31 @@ McRowHead::next() const
   return mNext;
 }
 
+// @brief 初期化する．
+// @param[in] pos 行番号
+// @param[in] dummy ダミーヘッダとして用いる要素
+inline
+void
+McRowHead::init(int pos,
+		McCell* dummy)
+{
+  mPos = pos;
+  mDummy = dummy;
+  mPrev = nullptr;
+  mNext = nullptr;
+  mDeleted = false;
+  mDirty = false;
+  mSig = 0ULL;
+  clear();
+}
+
 // @brief 接続している要素をクリアする．
 inline
 void
 McRowHead::clear()
 {
-  mDummy.mLeftLink = &mDummy;
-  mDummy.mRightLink = &mDummy;
+  mDummy->set_left(mDummy);
+  mDummy->set_right(mDummy);
   mNum = 0;
 }
 
@@ -231,15 +260,16 @@ inline
 void
 McRowHead::insert_elem(McCell* cell)
 {
-  McCell* prev = cell->mLeftLink;
-  McCell* next = cell->mRightLink;
+  McCell* prev = cell->left();
+  McCell* next = cell->right();
 
-  if ( prev->mRightLink != cell ) {
+  if ( prev->right() != cell ) {
     ++ mNum;
   }
+  mSig |= McCell::sig_bit(cell->col_pos());
 
-  prev->mRightLink = cell;
-  next->mLeftLink = cell;
+  prev->set_right(cell);
+  next->set_left(cell);
 }
 
 // @brief 要素を削除する．
@@ -248,11 +278,11 @@ inline
 void
 McRowHead::delete_elem(McCell* cell)
 {
-  McCell* prev = cell->mLeftLink;
-  McCell* next = cell->mRightLink;
+  McCell* prev = cell->left();
+  McCell* next = cell->right();
 
-  prev->mRightLink = next;
-  next->mLeftLink = prev;
+  prev->set_right(next);
+  next->set_left(prev);
   -- mNum;
 }
 
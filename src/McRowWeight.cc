@@ -0,0 +1,193 @@
+﻿
+/// @file McRowWeight.cc
+/// @brief McRowWeight の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McRowWeight.h"
+#include "McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+BEGIN_NONAMESPACE
+
+// 列のコストを要素数で割った値
+inline
+double
+col_weight(const McMatrix& matrix,
+	   const McColHead* col)
+{
+  return static_cast<double>(matrix.col_cost(col->pos())) / col->num();
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス McRowWeight
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] matrix 対象の行列
+McRowWeight::McRowWeight(const McMatrix& matrix) :
+  mWeightArray(matrix.row_size(), 0.0),
+  mActive(matrix.row_size(), false),
+  mSum(0.0),
+  mRowMark(matrix.row_size())
+{
+  for ( const McRowHead* row = matrix.row_front();
+	!matrix.is_row_end(row); row = row->next() ) {
+    int row_pos = row->pos();
+    mActive[row_pos] = true;
+    update_row(matrix, row_pos);
+  }
+  mUndoStack.clear();
+}
+
+// @brief デストラクタ
+McRowWeight::~McRowWeight()
+{
+}
+
+// @brief 行が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+//
+// row_pos を含む列の要素数が一つずつ減っているので，
+// それらの列を最小値として用いていた行を計算し直す．
+// 要素数が減ると値は増えるだけなので，他の行は変わらない．
+void
+McRowWeight::row_deleted(const McMatrix& matrix,
+			 int row_pos)
+{
+  ASSERT_COND( mActive[row_pos] );
+  push_frame();
+  mActive[row_pos] = false;
+  mSum -= mWeightArray[row_pos];
+
+  mRowMark.clear();
+  mRowList.clear();
+  const McRowHead* row = matrix.row(row_pos);
+  for ( const McCell* cell1 = row->front();
+	!row->is_end(cell1); cell1 = cell1->row_next() ) {
+    const McColHead* col = matrix.col(cell1->col_pos());
+    if ( col->num() == 0 ) {
+      // 空になった列は削除されている．
+      continue;
+    }
+    // 削除前の値と等しい行が計算し直す対象
+    double old_weight = static_cast<double>(matrix.col_cost(col->pos())) / (col->num() + 1);
+    for ( const McCell* cell2 = col->front();
+	  !col->is_end(cell2); cell2 = cell2->col_next() ) {
+      int row_pos2 = cell2->row_pos();
+      if ( mActive[row_pos2] && mWeightArray[row_pos2] == old_weight &&
+	   mRowMark.check_and_set(row_pos2) ) {
+	mRowList.push_back(row_pos2);
+      }
+    }
+  }
+  for ( auto row_pos2: mRowList ) {
+    update_row(matrix, row_pos2);
+  }
+}
+
+// @brief 列が削除された．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+//
+// 削除された列の要素のリストはそのまま残っているので，
+// その列を最小値として用いていた行を計算し直す．
+void
+McRowWeight::col_deleted(const McMatrix& matrix,
+			 int col_pos)
+{
+  push_frame();
+  const McColHead* col = matrix.col(col_pos);
+  if ( col->num() == 0 ) {
+    return;
+  }
+  double old_weight = col_weight(matrix, col);
+  for ( const McCell* cell = col->front();
+	!col->is_end(cell); cell = cell->col_next() ) {
+    int row_pos = cell->row_pos();
+    if ( mActive[row_pos] && mWeightArray[row_pos] == old_weight ) {
+      update_row(matrix, row_pos);
+    }
+  }
+}
+
+// @brief 行が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+void
+McRowWeight::row_restored(const McMatrix&,
+			  int row_pos)
+{
+  ASSERT_COND( !mActive[row_pos] );
+  pop_frame();
+  mActive[row_pos] = true;
+}
+
+// @brief 列が復元される．
+// @param[in] matrix 対象の行列
+// @param[in] col_pos 列番号
+void
+McRowWeight::col_restored(const McMatrix&,
+			  int)
+{
+  pop_frame();
+}
+
+// @brief 行の重みを計算し直す．
+// @param[in] matrix 対象の行列
+// @param[in] row_pos 行番号
+void
+McRowWeight::update_row(const McMatrix& matrix,
+			int row_pos)
+{
+  double min_weight = DBL_MAX;
+  const McRowHead* row = matrix.row(row_pos);
+  for ( const McCell* cell = row->front();
+	!row->is_end(cell); cell = cell->row_next() ) {
+    double weight = col_weight(matrix, matrix.col(cell->col_pos()));
+    if ( min_weight > weight ) {
+      min_weight = weight;
+    }
+  }
+  double old_weight = mWeightArray[row_pos];
+  if ( min_weight != old_weight ) {
+    mUndoStack.push_back(Undo{row_pos, old_weight});
+    mWeightArray[row_pos] = min_weight;
+    mSum += min_weight - old_weight;
+  }
+}
+
+// @brief 変更の区切りを積む．
+void
+McRowWeight::push_frame()
+{
+  mFrameStack.push_back(Frame{static_cast<int>(mUndoStack.size()), mSum});
+}
+
+// @brief 直前の区切りまでの変更を元に戻す．
+//
+// 重みの和は加減算の丸め誤差が残らないように保存した値に戻す．
+void
+McRowWeight::pop_frame()
+{
+  ASSERT_COND( !mFrameStack.empty() );
+  const Frame& frame = mFrameStack.back();
+  while ( static_cast<int>(mUndoStack.size()) > frame.mPos ) {
+    const Undo& undo = mUndoStack.back();
+    mWeightArray[undo.mRowPos] = undo.mWeight;
+    mUndoStack.pop_back();
+  }
+  mSum = frame.mSum;
+  mFrameStack.pop_back();
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,188 @@
+﻿#ifndef MCROWWEIGHT_H
+#define MCROWWEIGHT_H
+
+/// @file McRowWeight.h
+/// @brief McRowWeight のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McMatrixListener.h"
+#include "McMark.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McRowWeight McRowWeight.h "McRowWeight.h"
+/// @brief column splitting の行の重みを保持するクラス
+///
+/// 行の重みはその行を含む列のコストを列の要素数で割った値の最小値で，
+/// 削除されていない行の重みの和が LbCS の下界(の切り上げ前の値)になる．
+///
+/// 行や列の削除で値が変わるのは，要素数の変わった列か削除された列を
+/// 最小値として用いていた行だけなので，それらの行だけを計算し直す．
+/// 変更前の値はスタックに積んでおき，復元の時に書き戻す．
+//////////////////////////////////////////////////////////////////////
+class McRowWeight :
+  public McMatrixListener
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] matrix 対象の行列
+  ///
+  /// matrix の現在の内容から重みを求める．
+  explicit
+  McRowWeight(const McMatrix& matrix);
+
+  /// @brief デストラクタ
+  virtual
+  ~McRowWeight();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行の重みを返す．
+  /// @param[in] row_pos 行番号
+  ///
+  /// 削除されていない行に対してのみ意味を持つ．
+  double
+  weight(int row_pos) const;
+
+  /// @brief 削除されていない行の重みの和を返す．
+  double
+  sum() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McMatrixListener の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された．
+  virtual
+  void
+  row_deleted(const McMatrix& matrix,
+	      int row_pos);
+
+  /// @brief 列が削除された．
+  virtual
+  void
+  col_deleted(const McMatrix& matrix,
+	      int col_pos);
+
+  /// @brief 行が復元される．
+  virtual
+  void
+  row_restored(const McMatrix& matrix,
+	       int row_pos);
+
+  /// @brief 列が復元される．
+  virtual
+  void
+  col_restored(const McMatrix& matrix,
+	       int col_pos);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行の重みを計算し直す．
+  /// @param[in] matrix 対象の行列
+  /// @param[in] row_pos 行番号
+  ///
+  /// 変更前の値を mUndoStack に積む．
+  void
+  update_row(const McMatrix& matrix,
+	     int row_pos);
+
+  /// @brief 変更の区切りを積む．
+  void
+  push_frame();
+
+  /// @brief 直前の区切りまでの変更を元に戻す．
+  void
+  pop_frame();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変更前の行の重み
+  struct Undo
+  {
+    // 行番号
+    int mRowPos;
+
+    // 変更前の重み
+    double mWeight;
+  };
+
+  // 変更の区切り
+  struct Frame
+  {
+    // mUndoStack の位置
+    int mPos;
+
+    // 変更前の重みの和
+    double mSum;
+  };
+
+  // 各行の重みの配列
+  vector<double> mWeightArray;
+
+  // 有効な行の時 true となる配列
+  vector<bool> mActive;
+
+  // 重みの和
+  double mSum;
+
+  // 変更前の値のスタック
+  vector<Undo> mUndoStack;
+
+  // 行や列の削除ごとの区切りのスタック
+  vector<Frame> mFrameStack;
+
+  // 計算し直す行のマーク
+  McMark mRowMark;
+
+  // 計算し直す行のリスト
+  vector<int> mRowList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 行の重みを返す．
+// @param[in] row_pos 行番号
+inline
+double
+McRowWeight::weight(int row_pos) const
+{
+  return mWeightArray[row_pos];
+}
+
+// @brief 削除されていない行の重みの和を返す．
+inline
+double
+McRowWeight::sum() const
+{
+  return mSum;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCROWWEIGHT_H
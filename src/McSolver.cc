@@ -13,17 +13,19 @@
 #include "LbMAX.h"
 #include "LbMIS1.h"
 #include "LbMIS2.h"
+#include "LbMIS3.h"
 #include "LbCS.h"
+#include "LbLag.h"
+#include "LbDual.h"
 #include "SelSimple.h"
 #include "SelCS.h"
+#include "SelNaive.h"
 
 #include "ym/RandGen.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
-bool McSolver_debug = false;
-
 //////////////////////////////////////////////////////////////////////
 // クラス McSolver
 //////////////////////////////////////////////////////////////////////
@@ -31,12 +33,8 @@ bool McSolver_debug = false;
 // @brief コンストラクタ
 McSolver::McSolver()
 {
-  LbCalc* calc1 = new LbCS();
-  LbCalc* calc2 = new LbMIS1();
-  LbMAX* calc3 = new LbMAX();
-  calc3->add_calc(calc1);
-  calc3->add_calc(calc2);
-  mLbCalc = calc3;
+  mLbCalc = nullptr;
+  make_lb_calc();
 
   mSelector = new SelSimple();
   //mSelector = new SelCS();
@@ -50,7 +48,7 @@ McSolver::~McSolver()
   delete mLbCalc;
   delete mSelector;
   delete mMatrix;
-  delete mCostArray;
+  delete [] mCostArray;
 }
 
 // @brief 問題のサイズを設定する．
@@ -61,7 +59,7 @@ McSolver::set_size(int row_size,
 		   int col_size)
 {
   delete mMatrix;
-  delete mCostArray;
+  delete [] mCostArray;
   mCostArray = new int[col_size];
   for ( int i = 0; i < col_size; ++ i ) {
     mCostArray[i] = 1;
@@ -89,15 +87,100 @@ McSolver::insert_elem(int row_pos,
   mMatrix->insert_elem(row_pos, col_pos);
 }
 
+// @brief CSR 形式で問題を設定する．
+// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは行数 + 1 )
+// @param[in] col_idx 要素の列番号の配列
+// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+void
+McSolver::load_csr(const vector<int>& row_ptr,
+		   const vector<int>& col_idx,
+		   const vector<int>& col_cost_array)
+{
+  ASSERT_COND( !row_ptr.empty() );
+
+  int row_size = row_ptr.size() - 1;
+  int col_size = col_cost_array.size();
+  set_size(row_size, col_size);
+  for ( int i = 0; i < col_size; ++ i ) {
+    mCostArray[i] = col_cost_array[i];
+  }
+  mMatrix->load_csr(row_ptr, col_idx);
+}
+
+// @brief COO 形式で問題を設定する．
+// @param[in] row_size 行数
+// @param[in] row_idx 要素の行番号の配列
+// @param[in] col_idx 要素の列番号の配列
+// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+void
+McSolver::load_coo(int row_size,
+		   const vector<int>& row_idx,
+		   const vector<int>& col_idx,
+		   const vector<int>& col_cost_array)
+{
+  int col_size = col_cost_array.size();
+  set_size(row_size, col_size);
+  for ( int i = 0; i < col_size; ++ i ) {
+    mCostArray[i] = col_cost_array[i];
+  }
+  mMatrix->load_coo(row_idx, col_idx);
+}
+
 // @brief 最小被覆問題を解く．
 // @param[out] solution 選ばれた列集合
+// @param[in] thread_num 探索に用いるスレッド数
 // @return 解のコスト
 int
-McSolver::exact(vector<int>& solution)
+McSolver::exact(vector<int>& solution,
+		int thread_num)
 {
-  McSolverImpl impl(*mMatrix, *mLbCalc, *mSelector);
+  mLbCalc->set_parallel(mOption.mParallelLb);
+  McSolverImpl impl(*mMatrix, *mLbCalc, *mSelector, mOption);
 
-  int cost = impl.exact(solution);
+  int cost = impl.exact(solution, thread_num);
+
+  return cost;
+}
+
+// @brief 複数の設定を並列に走らせて最小被覆問題を解く．
+// @param[out] solution 選ばれた列集合
+// @return 解のコスト
+//
+// 下界の計算クラスと列を選択するクラスの組み合わせによって
+// 得手不得手があるので，いくつかの組み合わせを同時に走らせて
+// 最初に探索を終えたものの結果を用いる．
+int
+McSolver::exact_portfolio(vector<int>& solution)
+{
+  vector<LbCalc*> lb_calc_list;
+  vector<Selector*> selector_list;
+
+  mLbCalc->set_parallel(mOption.mParallelLb);
+
+  // デフォルトの設定
+  lb_calc_list.push_back(mLbCalc->clone());
+  selector_list.push_back(mSelector->clone());
+
+  // 列の選択に SelCS を用いる．
+  lb_calc_list.push_back(mLbCalc->clone());
+  selector_list.push_back(new SelCS());
+
+  // 下界を LbCS のみにして1ノードあたりの処理を軽くする．
+  lb_calc_list.push_back(new LbCS());
+  selector_list.push_back(new SelSimple());
+
+  lb_calc_list.push_back(new LbCS());
+  selector_list.push_back(new SelNaive());
+
+  int cost = McSolverImpl::portfolio(*mMatrix, lb_calc_list, selector_list,
+				     mOption, solution);
+
+  for ( auto lb_calc: lb_calc_list ) {
+    delete lb_calc;
+  }
+  for ( auto selector: selector_list ) {
+    delete selector;
+  }
 
   return cost;
 }
@@ -110,28 +193,110 @@ int
 McSolver::heuristic(const string& algorithm,
 		    vector<int>& solution)
 {
-  McMatrix cur_matrix(*mMatrix);
+  int lower_bound;
+  return heuristic_sub(algorithm, solution, false, lower_bound);
+}
+
+// @brief ヒューリスティックで最小被覆問題を解き，下界も求める．
+// @param[in] algorithm ヒューリスティックの名前
+// @param[out] solution 選ばれた列集合
+// @param[out] lower_bound 最適解のコストの下界
+// @return 解のコスト
+int
+McSolver::heuristic(const string& algorithm,
+		    vector<int>& solution,
+		    int& lower_bound)
+{
+  return heuristic_sub(algorithm, solution, true, lower_bound);
+}
+
+// @brief オプションに従って下界の計算クラスを作る．
+void
+McSolver::make_lb_calc()
+{
+  delete mLbCalc;
+  mLbCalc = new LbMAX();
+  for ( auto& name: mOption.mLbList ) {
+    if ( name == "cs" ) {
+      mLbCalc->add_calc(new LbCS());
+    }
+    else if ( name == "mis1" ) {
+      LbMIS1* calc = new LbMIS1();
+      calc->set_ls_iter_num(mOption.mMisLsIterNum);
+      mLbCalc->add_calc(calc);
+    }
+    else if ( name == "mis2" ) {
+      LbMIS2* calc = new LbMIS2();
+      calc->set_ls_iter_num(mOption.mMisLsIterNum);
+      mLbCalc->add_calc(calc);
+    }
+    else if ( name == "mis3" ) {
+      mLbCalc->add_calc(new LbMIS3());
+    }
+    else if ( name == "lagrangian" ) {
+      mLbCalc->add_calc(new LbLag());
+    }
+    else if ( name == "dual" ) {
+      mLbCalc->add_calc(new LbDual());
+    }
+  }
+}
+
+// @brief heuristic() の本体
+// @param[in] algorithm ヒューリスティックの名前
+// @param[out] solution 選ばれた列集合
+// @param[in] need_lb 下界も求める時 true にする．
+// @param[out] lower_bound 最適解のコストの下界
+// @return 解のコスト
+int
+McSolver::heuristic_sub(const string& algorithm,
+			vector<int>& solution,
+			bool need_lb,
+			int& lower_bound)
+{
+  // 行列をコピーする代わりに削除スタックを用いて元に戻す．
+  McMatrix& cur_matrix = *mMatrix;
+  cur_matrix.save();
 
   solution.clear();
-  cur_matrix.reduce(solution);
+  cur_matrix.reduce(solution, mOption);
+
+  // 簡単化で選ばれた列は最適解にも含まれる．
+  lower_bound = mMatrix->cost(solution);
 
   if ( cur_matrix.row_num() > 0 ) {
 
-    if ( algorithm == "greedy" ) {
-      greedy(cur_matrix, solution);
-    }
-    else if ( algorithm == "random" ) {
-      random(cur_matrix, solution);
-    }
-    else if ( algorithm == "MCT" ) {
-      ;
+    if ( algorithm == "lagrangian" ) {
+      int lb;
+      lagrangian(cur_matrix, solution, lb);
+      lower_bound += lb;
     }
     else {
-      // デフォルトフォールバックは greedy
-      greedy(cur_matrix, solution);
+      if ( need_lb ) {
+	// 後で exact() を呼んだ時に影響しないように
+	// 乗数などの状態を持たない複製で計算する．
+	LbCalc* lb_calc = mLbCalc->clone();
+	lower_bound += (*lb_calc)(cur_matrix);
+	delete lb_calc;
+      }
+      if ( algorithm == "greedy" ) {
+	greedy(cur_matrix, solution);
+      }
+      else if ( algorithm == "random" ) {
+	random(cur_matrix, solution);
+      }
+      else if ( algorithm == "MCT" ) {
+	;
+      }
+      else {
+	// デフォルトフォールバックは greedy
+	greedy(cur_matrix, solution);
+      }
     }
   }
 
+  cur_matrix.restore();
+
   ASSERT_COND( mMatrix->verify(solution) );
 
   int cost = mMatrix->cost(solution);
@@ -143,10 +308,10 @@ McSolver::heuristic(const string& algorithm,
 // @param[in] matrix 対象の行列
 // @param[out] solution 選ばれた列集合
 void
-McSolver::greedy(const McMatrix& matrix,
+McSolver::greedy(McMatrix& matrix,
 		 vector<int>& solution)
 {
-  if ( McSolver_debug ) {
+  if ( mOption.mHeuristicDebug ) {
     cout << "McSolver::greedy() start" << endl;
   }
 
@@ -162,29 +327,43 @@ McSolver::greedy(const McMatrix& matrix,
     cur_matrix.select_col(col);
     solution.push_back(col);
 
-    if ( McSolver_debug ) {
+    if ( mOption.mHeuristicDebug ) {
       cout << "Col#" << col << " is selected heuristically" << endl;
     }
 
-    cur_matrix.reduce(solution);
+    cur_matrix.reduce(solution, mOption);
   }
   }
 #endif
-  McMatrix cur_matrix(matrix);
+  // 列の評価値を差分更新させておけば，各反復で列を選ぶのは
+  // ヒープの根を見るだけになる．
+  // matrix には呼び出し側の削除も積まれているので，この関数の中でだけ使う．
+  bool use_col_score = mSelector->need_col_score() && matrix.col_score() == nullptr;
+  if ( use_col_score ) {
+    matrix.make_col_score();
+  }
 
-  while ( cur_matrix.row_num() > 0 ) {
+  matrix.save();
+
+  while ( matrix.row_num() > 0 ) {
     // 次の分岐のための列をとってくる．
-    int col = (*mSelector)(cur_matrix);
+    int col = (*mSelector)(matrix);
 
     // その列を選択する．
-    cur_matrix.select_col(col);
+    matrix.select_col(col);
     solution.push_back(col);
 
-    if ( McSolver_debug ) {
+    if ( mOption.mHeuristicDebug ) {
       cout << "Col#" << col << " is selected heuristically" << endl;
     }
 
-    cur_matrix.reduce(solution);
+    matrix.reduce(solution, mOption);
+  }
+
+  matrix.restore();
+
+  if ( use_col_score ) {
+    matrix.delete_col_score();
   }
 }
 
@@ -192,10 +371,10 @@ McSolver::greedy(const McMatrix& matrix,
 // @param[in] matrix 対象の行列
 // @param[out] solution 選ばれた列集合
 void
-McSolver::random(const McMatrix& matrix,
+McSolver::random(McMatrix& matrix,
 		 vector<int>& solution)
 {
-  if ( McSolver_debug ) {
+  if ( mOption.mHeuristicDebug ) {
     cout << "McSolver::random() start" << endl;
   }
 
@@ -206,14 +385,16 @@ McSolver::random(const McMatrix& matrix,
   bool first = true;
   int best_cost = 0;
   vector<int> best_solution;
+  vector<int> cur_solution;
   for ( int count = 0; count < count_limit; ++ count ) {
-    McMatrix cur_matrix(matrix);
-    vector<int> cur_solution;
+    // 毎回行列をコピーする代わりに save()/restore() で元に戻す．
+    matrix.save();
+    cur_solution.clear();
 
-    while ( cur_matrix.row_num() > 0 ) {
+    while ( matrix.row_num() > 0 ) {
       // ランダムに選ぶ
       int col = 0; // 未完
-      const McRowHead* rh = cur_matrix.row_front();
+      const McRowHead* rh = matrix.row_front();
       int n = rh->num();
       ASSERT_COND( n > 0 );
       int idx = rg.int32() % n;
@@ -226,11 +407,13 @@ McSolver::random(const McMatrix& matrix,
       }
 
       // その列を選択する
-      cur_matrix.select_col(col);
+      matrix.select_col(col);
       cur_solution.push_back(col);
 
-      cur_matrix.reduce(cur_solution);
+      matrix.reduce(cur_solution, mOption);
     }
+    matrix.restore();
+
     int cur_cost = matrix.cost(cur_solution);
     if ( first || best_cost > cur_cost ) {
       first = false;
@@ -249,6 +432,188 @@ McSolver::random(const McMatrix& matrix,
   }
 }
 
+// @brief ラグランジュ緩和を用いたヒューリスティックで解を求める．
+// @param[in] matrix 対象の行列
+// @param[out] solution 選ばれた列集合
+// @param[out] lower_bound matrix の最適解のコストの下界
+//
+// L(u) の計算と乗数の更新は LbLag と共通で，劣勾配法の目標値には
+// その時点で最良の解のコストを用いる．
+void
+McSolver::lagrangian(McMatrix& matrix,
+		     vector<int>& solution,
+		     int& lower_bound)
+{
+  if ( mOption.mHeuristicDebug ) {
+    cout << "McSolver::lagrangian() start" << endl;
+  }
+
+  int count_limit = 1000;
+
+  int nr = matrix.row_size();
+  int nc = matrix.col_size();
+
+  // 乗数は column splitting の値から始める．
+  vector<double> mult(nr, 0.0);
+  LbCS::row_weights(matrix, mult);
+
+  // 作業用の配列
+  vector<double> rc_array(nc, 0.0);
+  vector<int> subgrad(nr, 0);
+  vector<int> cover_num(nr, 0);
+  vector<int> cur_solution;
+
+
+  // 初期解(と劣勾配法の目標値)には greedy() の解を用いる．
+  vector<int> best_solution;
+  greedy(matrix, best_solution);
+  int best_cost = matrix.cost(best_solution);
+
+  double best_lb = 0.0;
+  double step_factor = 2.0;
+  int fail_count = 0;
+  for ( int count = 0; count < count_limit; ++ count ) {
+    // L(u) と縮約コストと劣勾配を求める．
+    double val = LbLag::eval(matrix, mult, rc_array, subgrad);
+
+    // 緩和問題の解(縮約コストが負の列)から始めて，
+    // 被覆されていない行は，その行を含む列のうち
+    // 被覆されていない行1つあたりのコストが最小のもので被覆する．
+    cur_solution.clear();
+    for ( const McColHead* col = matrix.col_front();
+	  !matrix.is_col_end(col); col = col->next() ) {
+      if ( rc_array[col->pos()] < 0.0 ) {
+	cur_solution.push_back(col->pos());
+      }
+    }
+    // 劣勾配は 1 - (その行を被覆する緩和問題の解の列の数)
+    for ( const McRowHead* row = matrix.row_front();
+	  !matrix.is_row_end(row); row = row->next() ) {
+      cover_num[row->pos()] = 1 - subgrad[row->pos()];
+    }
+    for ( const McRowHead* row = matrix.row_front();
+	  !matrix.is_row_end(row); row = row->next() ) {
+      if ( cover_num[row->pos()] > 0 ) {
+	continue;
+      }
+      int min_col = -1;
+      double min_val = DBL_MAX;
+      for ( const McCell* cell = row->front();
+	    !row->is_end(cell); cell = cell->row_next() ) {
+	int col_pos = cell->col_pos();
+	const McColHead* col = matrix.col(col_pos);
+	int n = 0;
+	for ( const McCell* cell1 = col->front();
+	      !col->is_end(cell1); cell1 = cell1->col_next() ) {
+	  if ( cover_num[cell1->row_pos()] == 0 ) {
+	    ++ n;
+	  }
+	}
+	double val1 = static_cast<double>(matrix.col_cost(col_pos)) / n;
+	if ( min_val > val1 ||
+	     ( min_val == val1 && rc_array[min_col] > rc_array[col_pos] ) ) {
+	  min_val = val1;
+	  min_col = col_pos;
+	}
+      }
+      cur_solution.push_back(min_col);
+      const McColHead* col = matrix.col(min_col);
+      for ( const McCell* cell = col->front();
+	    !col->is_end(cell); cell = cell->col_next() ) {
+	++ cover_num[cell->row_pos()];
+      }
+    }
+
+    // コストの大きい列から順に，取り除いても被覆が保たれるものを取り除く．
+    // コストが等しい時は縮約コストの大きい列を先に調べる．
+    sort(cur_solution.begin(), cur_solution.end(),
+	 [&](int a, int b) {
+	   int cost_a = matrix.col_cost(a);
+	   int cost_b = matrix.col_cost(b);
+	   if ( cost_a != cost_b ) {
+	     return cost_a > cost_b;
+	   }
+	   return rc_array[a] > rc_array[b];
+	 });
+    int cur_cost = 0;
+    int wpos = 0;
+    for ( auto col_pos: cur_solution ) {
+      const McColHead* col = matrix.col(col_pos);
+      bool redundant = true;
+      for ( const McCell* cell = col->front();
+	    !col->is_end(cell); cell = cell->col_next() ) {
+	if ( cover_num[cell->row_pos()] == 1 ) {
+	  redundant = false;
+	  break;
+	}
+      }
+      if ( redundant ) {
+	for ( const McCell* cell = col->front();
+	      !col->is_end(cell); cell = cell->col_next() ) {
+	  -- cover_num[cell->row_pos()];
+	}
+      }
+      else {
+	cur_solution[wpos] = col_pos;
+	++ wpos;
+	cur_cost += matrix.col_cost(col_pos);
+      }
+    }
+    cur_solution.resize(wpos);
+
+    if ( best_cost > cur_cost ) {
+      best_cost = cur_cost;
+      best_solution = cur_solution;
+      if ( mOption.mHeuristicDebug ) {
+	cout << "[" << count << "] best so far = " << best_cost << endl;
+      }
+    }
+    bool improved = best_lb < val;
+    if ( improved ) {
+      best_lb = val;
+    }
+    // しばらく改善しなかったら歩幅を半分にする．
+    LbLag::update_step(improved, 20, fail_count, step_factor);
+
+    // 最適性が示されたか，歩幅が小さくなりすぎたら終わる．
+    if ( LbCalc::ceil_lb(best_lb) >= best_cost || step_factor < 1.0e-3 ) {
+      break;
+    }
+
+    if ( !LbLag::update_mult(matrix, subgrad, step_factor, best_cost - val, mult) ) {
+      break;
+    }
+  }
+
+  if ( mOption.mHeuristicDebug ) {
+    cout << "McSolver::lagrangian() end: " << best_cost
+	 << " (lb = " << best_lb << ")" << endl;
+  }
+
+  for ( auto col: best_solution ) {
+    solution.push_back(col);
+  }
+  lower_bound = LbCalc::ceil_lb(best_lb);
+}
+
+// @brief 下界の計算クラスを設定する．
+// @param[in] name_list 下界の計算クラスの名前のリスト
+void
+McSolver::set_lb_list(const vector<string>& name_list)
+{
+  mOption.mLbList = name_list;
+  make_lb_calc();
+}
+
+// @brief MIS 下界の局所探索の反復回数を設定する．
+// @param[in] iter_num 反復回数
+void
+McSolver::set_mis_ls_iter_num(int iter_num)
+{
+  mOption.mMisLsIterNum = iter_num;
+  make_lb_calc();
+}
+
 // @brief 内部の行列の内容を出力する．
 // @param[in] s 出力先のストリーム
 void
@@ -11,6 +11,7 @@
 
 #include "ym/ym_mincov.h"
 #include "ym/MinCov.h"
+#include "McOption.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -56,11 +57,39 @@ public:
   insert_elem(int row_pos,
 	      int col_pos);
 
+  /// @brief CSR 形式で問題を設定する．
+  /// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは行数 + 1 )
+  /// @param[in] col_idx 要素の列番号の配列
+  /// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+  void
+  load_csr(const vector<int>& row_ptr,
+	   const vector<int>& col_idx,
+	   const vector<int>& col_cost_array);
+
+  /// @brief COO 形式で問題を設定する．
+  /// @param[in] row_size 行数
+  /// @param[in] row_idx 要素の行番号の配列
+  /// @param[in] col_idx 要素の列番号の配列
+  /// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+  void
+  load_coo(int row_size,
+	   const vector<int>& row_idx,
+	   const vector<int>& col_idx,
+	   const vector<int>& col_cost_array);
+
   /// @brief 最小被覆問題を解く．
   /// @param[out] solution 選ばれた列集合
+  /// @param[in] thread_num 探索に用いるスレッド数
   /// @return 解のコスト
   int
-  exact(vector<int>& solution);
+  exact(vector<int>& solution,
+	int thread_num);
+
+  /// @brief 複数の設定を並列に走らせて最小被覆問題を解く．
+  /// @param[out] solution 選ばれた列集合
+  /// @return 解のコスト
+  int
+  exact_portfolio(vector<int>& solution);
 
   /// @brief ヒューリスティックで最小被覆問題を解く．
   /// @param[in] algorithm ヒューリスティックの名前
@@ -70,31 +99,96 @@ public:
   heuristic(const string& algorithm,
 	    vector<int>& solution);
 
+  /// @brief ヒューリスティックで最小被覆問題を解き，下界も求める．
+  /// @param[in] algorithm ヒューリスティックの名前
+  /// @param[out] solution 選ばれた列集合
+  /// @param[out] lower_bound 最適解のコストの下界
+  /// @return 解のコスト
+  int
+  heuristic(const string& algorithm,
+	    vector<int>& solution,
+	    int& lower_bound);
+
+  /// @brief 下界の計算クラスを設定する．
+  /// @param[in] name_list 下界の計算クラスの名前のリスト
+  ///
+  /// 軽いものから順に並べること．
+  /// 名前は "cs", "mis1", "mis2", "mis3", "lagrangian", "dual" のいずれか．
+  /// 知らない名前は無視する．
+  void
+  set_lb_list(const vector<string>& name_list);
+
+  /// @brief MIS 下界の局所探索の反復回数を設定する．
+  /// @param[in] iter_num 反復回数
+  ///
+  /// "mis1", "mis2" の下界に適用される．
+  /// 0 の時は局所探索を行わない．
+  void
+  set_mis_ls_iter_num(int iter_num);
+
   /// @brief 内部の行列の内容を出力する．
   /// @param[in] s 出力先のストリーム
   void
   print_matrix(ostream& s);
 
+  /// @brief オプションを返す．
+  McOption&
+  option();
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief オプションに従って下界の計算クラスを作る．
+  void
+  make_lb_calc();
+
+  /// @brief heuristic() の本体
+  /// @param[in] algorithm ヒューリスティックの名前
+  /// @param[out] solution 選ばれた列集合
+  /// @param[in] need_lb 下界も求める時 true にする．
+  /// @param[out] lower_bound 最適解のコストの下界
+  /// @return 解のコスト
+  ///
+  /// need_lb が false の時は "lagrangian" 以外では lower_bound は
+  /// 簡単化で選ばれた列のコストのみとなる．
+  int
+  heuristic_sub(const string& algorithm,
+		vector<int>& solution,
+		bool need_lb,
+		int& lower_bound);
+
   /// @grief greedy アルゴリズムで解を求める．
   /// @param[in] matrix 対象の行列
   /// @param[out] solution 選ばれた列集合
+  /// @note matrix は save()/restore() で元の状態に戻される．
   void
-  greedy(const McMatrix& matrix,
+  greedy(McMatrix& matrix,
 	 vector<int>& solution);
 
   /// @grief naive な random アルゴリズムで解を求める．
   /// @param[in] matrix 対象の行列
   /// @param[out] solution 選ばれた列集合
+  /// @note matrix は save()/restore() で元の状態に戻される．
   void
-  random(const McMatrix& matrix,
+  random(McMatrix& matrix,
 	 vector<int>& solution);
 
+  /// @brief ラグランジュ緩和を用いたヒューリスティックで解を求める．
+  /// @param[in] matrix 対象の行列
+  /// @param[out] solution 選ばれた列集合
+  /// @param[out] lower_bound matrix の最適解のコストの下界
+  ///
+  /// 劣勾配法の各反復で乗数から被覆を作り，冗長な列を取り除いたもののうち
+  /// 最良のものを solution に追加する．(Beasley の方法)
+  /// matrix は変更しない．
+  void
+  lagrangian(McMatrix& matrix,
+	     vector<int>& solution,
+	     int& lower_bound);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -102,7 +196,7 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 下界を計算するクラス
-  LbCalc* mLbCalc;
+  LbMAX* mLbCalc;
 
   // 列を選ぶクラス
   Selector* mSelector;
@@ -113,8 +207,24 @@ private:
   // コストの配列
   int* mCostArray;
 
+  // オプション
+  McOption mOption;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief オプションを返す．
+inline
+McOption&
+McSolver::option()
+{
+  return mOption;
+}
+
 END_NAMESPACE_YM_MINCOV
 
 #endif // MCSOLVER_H
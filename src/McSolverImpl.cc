@@ -14,13 +14,14 @@
 #include "McCell.h"
 #include "LbCalc.h"
 #include "Selector.h"
+#include "McIncumbent.h"
+#include "McTaskPool.h"
+#include <chrono>
+#include <thread>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
-static
-int solve_id = 0;
-
 // 2つの行列が等しいかをチェックする関数
 // 等しくなければ例外を送出する．
 void
@@ -84,6 +85,52 @@ verify_matrix(McMatrix& a,
   }
 }
 
+BEGIN_NONAMESPACE
+
+// 行の重みを差分更新させる最小の行数
+const int ROW_WEIGHT_MIN_NUM = 1000;
+
+// 行の重みを差分更新させる列の平均要素数の上限
+const int ROW_WEIGHT_MAX_COL_LEN = 16;
+
+// 行の重みを差分更新させる時 true を返す．
+//
+// 小さい行列や列の長い行列では差分更新の手間の方が大きいので
+// LbCS が毎回求め直す方が速い．
+bool
+use_row_weight(const McMatrix& matrix)
+{
+  if ( matrix.row_num() < ROW_WEIGHT_MIN_NUM ) {
+    return false;
+  }
+  int elem_num = 0;
+  for ( const McColHead* col = matrix.col_front();
+	!matrix.is_col_end(col); col = col->next() ) {
+    elem_num += col->num();
+  }
+  return elem_num <= matrix.col_num() * ROW_WEIGHT_MAX_COL_LEN;
+}
+
+// 探索したノード数を出力する．
+// debug が true の時は探索時間とスループットも出力する．
+void
+print_branch_num(int node_num,
+		 double sec,
+		 bool debug)
+{
+  cout << "Total branch: " << node_num;
+  if ( debug ) {
+    cout << " (" << sec << " sec";
+    if ( sec > 0.0 ) {
+      cout << ", " << (node_num / sec) << " nodes/sec";
+    }
+    cout << ")";
+  }
+  cout << endl;
+}
+
+END_NONAMESPACE
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス McSolverImpl
@@ -93,53 +140,127 @@ verify_matrix(McMatrix& a,
 // @param[in] matrix 問題の行列
 // @param[in] lb_calc 下界の計算クラス
 // @param[in] selector 列を選択するクラス
+// @param[in] option オプション
 McSolverImpl::McSolverImpl(const McMatrix& matrix,
 			   LbCalc& lb_calc,
-			   Selector& selector) :
+			   Selector& selector,
+			   const McOption& option) :
+  mLbCalc(lb_calc),
+  mSelector(selector),
   mMatrix(matrix),
+  mGroup(nullptr),
+  mContrib(0),
+  mIncumbent(nullptr),
+  mPool(nullptr),
+  mWorkerId(0),
+  mStop(nullptr),
+  mContext(new Context(option)),
+  mOwnContext(true)
+{
+  attach_listeners();
+}
+
+// @brief 並列探索のワーカ用のコンストラクタ
+// @param[in] matrix 問題の行列
+// @param[in] lb_calc 下界の計算クラス
+// @param[in] selector 列を選択するクラス
+// @param[in] context 共有する情報
+McSolverImpl::McSolverImpl(const McMatrix& matrix,
+			   LbCalc& lb_calc,
+			   Selector& selector,
+			   Context* context) :
   mLbCalc(lb_calc),
-  mSelector(selector)
+  mSelector(selector),
+  mMatrix(matrix),
+  mGroup(nullptr),
+  mContrib(0),
+  mIncumbent(nullptr),
+  mPool(nullptr),
+  mWorkerId(0),
+  mStop(nullptr),
+  mContext(context),
+  mOwnContext(false)
 {
+  attach_listeners();
 }
 
-// @brief コンストラクタ
+// @brief ブロック分割用のコンストラクタ
 // @param[in] matrix 問題の行列
 // @param[in] row_list 注目する行番号のリスト
 // @param[in] col_list 注目する列番号のリスト
 // @param[in] lb_calc 下界の計算クラス
 // @param[in] selector 列を選択するクラス
+// @param[in] context 共有する情報
 McSolverImpl::McSolverImpl(McMatrix& matrix,
 			   const vector<int>& row_list,
 			   const vector<int>& col_list,
 			   LbCalc& lb_calc,
-			   Selector& selector) :
-  mMatrix(matrix, row_list, col_list),
+			   Selector& selector,
+			   Context* context) :
   mLbCalc(lb_calc),
-  mSelector(selector)
+  mSelector(selector),
+  mMatrix(matrix, row_list, col_list),
+  mGroup(nullptr),
+  mContrib(0),
+  mIncumbent(nullptr),
+  mPool(nullptr),
+  mWorkerId(0),
+  mStop(nullptr),
+  mContext(context),
+  mOwnContext(false)
+{
+  attach_listeners();
+}
+
+// @brief 下界の計算で用いるものを行列に持たせる．
+//
+// 下界の計算で用いるなら行の衝突グラフと行の重みを差分更新させる．
+void
+McSolverImpl::attach_listeners()
 {
+  if ( mLbCalc.need_conflict_graph() ) {
+    mMatrix.make_conflict_graph();
+  }
+  if ( mLbCalc.need_row_weight() && use_row_weight(mMatrix) ) {
+    mMatrix.make_row_weight();
+  }
 }
 
 // @brief デストラクタ
 McSolverImpl::~McSolverImpl()
 {
+  if ( mOwnContext ) {
+    delete mContext;
+  }
 }
 
 // @brief 最小被覆問題を解く．
 // @param[out] solution 選ばれた列集合
+// @param[in] thread_num 探索に用いるスレッド数
 // @return 解のコスト
 int
-McSolverImpl::exact(vector<int>& solution)
+McSolverImpl::exact(vector<int>& solution,
+		    int thread_num)
 {
   // 検証用にもとの行列をコピーしておく．
   McMatrix orig_matrix(mMatrix);
   // こちらは McMatrix 自身が持つ復元機能
   mMatrix.save();
 
-  solve_id = 0;
+  mContext->mSolveId = 0;
 
-  mBest = UINT_MAX;
+  mBest = INT_MAX;
   mCurSolution.clear();
-  bool stat = solve(0, 0);
+  mExcludedCols.clear();
+  auto start = std::chrono::steady_clock::now();
+  bool stat;
+  if ( thread_num > 1 ) {
+    stat = solve_parallel(thread_num);
+  }
+  else {
+    stat = solve(0, 0);
+  }
+  auto end = std::chrono::steady_clock::now();
   ASSERT_COND( stat );
 
   solution = mBestSolution;
@@ -151,30 +272,120 @@ McSolverImpl::exact(vector<int>& solution)
   // solution がカバーになっているかチェックする．
   ASSERT_COND( mMatrix.verify(solution) );
 
-  cout << "Total branch: " << solve_id << endl;
+  double sec = std::chrono::duration<double>(end - start).count();
+  print_branch_num(mContext->mSolveId, sec, mContext->mOption.mDebug);
 
   return mBest;
 }
 
+// @brief 複数の設定で並列に探索する．
+// @param[in] matrix 問題の行列
+// @param[in] lb_calc_list 下界の計算クラスのリスト
+// @param[in] selector_list 列を選択するクラスのリスト
+// @param[in] option オプション
+// @param[out] solution 選ばれた列集合
+// @return 解のコスト
+//
+// どの設定でも探索を最後まで終えれば暫定解の最適性が証明されるので，
+// 最初に終わったスレッドが他のスレッドを止める．
+int
+McSolverImpl::portfolio(const McMatrix& matrix,
+			const vector<LbCalc*>& lb_calc_list,
+			const vector<Selector*>& selector_list,
+			const McOption& option,
+			vector<int>& solution)
+{
+  ASSERT_COND( selector_list.size() == lb_calc_list.size() );
+  int n = lb_calc_list.size();
+
+  Context context(option);
+  McIncumbent incumbent;
+  std::atomic<bool> stop(false);
+  vector<McSolverImpl*> solver_list(n);
+  for ( int i = 0; i < n; ++ i ) {
+    McSolverImpl* solver = new McSolverImpl(matrix, *lb_calc_list[i], *selector_list[i],
+					    &context);
+    solver->mBest = INT_MAX;
+    solver->mIncumbent = &incumbent;
+    solver->mStop = &stop;
+    solver_list[i] = solver;
+  }
+
+  auto run = [&](McSolverImpl* solver) {
+    solver->solve(0, 0);
+    // 打ち切られずに戻ってきたのなら最適性が証明されている．
+    stop = true;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  vector<std::thread> thread_list;
+  thread_list.reserve(n - 1);
+  for ( int i = 1; i < n; ++ i ) {
+    thread_list.push_back(std::thread(run, solver_list[i]));
+  }
+  run(solver_list[0]);
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  for ( auto solver: solver_list ) {
+    delete solver;
+  }
+
+  ASSERT_COND( incumbent.cost() < INT_MAX );
+  solution = incumbent.solution();
+  ASSERT_COND( matrix.verify(solution) );
+
+  double sec = std::chrono::duration<double>(end - start).count();
+  print_branch_num(context.mSolveId, sec, option.mDebug);
+
+  return incumbent.cost();
+}
+
 // @brief 解を求める再帰関数
 bool
 McSolverImpl::solve(int lb,
 		    int depth)
 {
-  int cur_id = solve_id;
-  ++ solve_id;
+  int cur_id = mContext->mSolveId ++;
+
+  if ( aborted() ) {
+    return false;
+  }
 
-  mMatrix.reduce(mCurSolution);
+  mMatrix.reduce(mCurSolution, mContext->mOption);
 
   int tmp_cost = mMatrix.cost(mCurSolution);
 
-  int tmp_lb = mLbCalc(mMatrix) + tmp_cost;
+  // 下界が bound() に達すればこのノードは枝刈りされるので
+  // それ以上正確に求める必要はない．
+  int tmp_lb = mLbCalc(mMatrix, bound() - tmp_cost) + tmp_cost;
   if ( lb < tmp_lb ) {
     lb = tmp_lb;
   }
 
-  bool cur_debug = mDebug;
-  if (depth > mMaxDepth) {
+  const McOption& option = mContext->mOption;
+
+  // 縮約コストで固定できる列を削除する．
+  // 削除した列があれば簡単化をやり直す．
+  // 簡単化で選ばれた列の分だけ現在の解のコストが下界を超えることがある．
+  if ( lb < bound() ) {
+    int nfix = fix_cols(tmp_cost);
+    if ( nfix < 0 ) {
+      // bound() より良い解はない．
+      lb = bound();
+    }
+    else if ( nfix > 0 ) {
+      mMatrix.reduce(mCurSolution, option);
+      tmp_cost = mMatrix.cost(mCurSolution);
+      if ( lb < tmp_cost ) {
+	lb = tmp_cost;
+      }
+    }
+  }
+  bool cur_debug = option.mDebug;
+  if (depth > option.mMaxDepth) {
     cur_debug = false;
   }
 
@@ -182,11 +393,11 @@ McSolverImpl::solve(int lb,
     int nr = mMatrix.row_num();
     int nc = mMatrix.col_num();
     cout << "[" << depth << "] " << nr << "x" << nc
-	 << " sel=" << tmp_cost << " bnd=" << mBest
+	 << " sel=" << tmp_cost << " bnd=" << bound()
 	 << " lb=" << lb;
   }
 
-  if ( lb >= mBest ) {
+  if ( lb >= bound() ) {
     if ( cur_debug ) {
       cout << " bounded" << endl;
     }
@@ -194,61 +405,18 @@ McSolverImpl::solve(int lb,
   }
 
   if ( mMatrix.row_num() == 0 ) {
-    mBest = tmp_cost;
-    mBestSolution = mCurSolution;
+    update_best(tmp_cost);
     if ( cur_debug ) {
       cout << " best" << endl;
     }
     return true;
   }
 
-  vector<int> row_list1;
-  vector<int> row_list2;
-  vector<int> col_list1;
-  vector<int> col_list2;
-  if ( mDoPartition && mMatrix.block_partition(row_list1, row_list2, col_list1, col_list2) ) {
+  vector<vector<int>> row_list_array;
+  vector<vector<int>> col_list_array;
+  if ( option.mDoPartition && mMatrix.block_partition(row_list_array, col_list_array) ) {
     // ブロック分割を行う．
-    McSolverImpl solver1(mMatrix, row_list1, col_list1, mLbCalc, mSelector);
-    McSolverImpl solver2(mMatrix, row_list2, col_list2, mLbCalc, mSelector);
-    if ( cur_debug ) {
-      cout << endl
-	   << "BLOCK PARTITION" << endl;
-      cout << "Matrix#1" << endl;
-      solver1.matrix().print(cout);
-      cout << "Matrix#2" << endl;
-      solver2.matrix().print(cout);
-    }
-    solver1.mMatrix.save();
-    solver2.mMatrix.save();
-    int cost_so_far = mMatrix.cost(mCurSolution);
-    int lb_rest = mLbCalc(solver2.matrix());
-    solver1.mBest = mBest - cost_so_far - lb_rest;
-    solver1.mCurSolution.clear();
-    bool stat1 = solver1.solve(0, depth + 1);
-    if ( stat1 ) {
-      mCurSolution.insert(mCurSolution.end(), solver1.mBestSolution.begin(), solver1.mBestSolution.end());
-      cost_so_far += solver1.mBest;
-      solver2.mBest = mBest - cost_so_far;
-      solver2.mCurSolution.clear();
-      stat1 = solver2.solve(0, depth + 1);
-      if ( stat1 ) {
-	mCurSolution.insert(mCurSolution.end(), solver2.mBestSolution.begin(), solver2.mBestSolution.end());
-	cost_so_far += solver2.mBest;
-      }
-    }
-    solver1.mMatrix.restore();
-    solver2.mMatrix.restore();
-    mMatrix.merge(solver1.mMatrix, solver2.mMatrix);
-
-    if ( stat1 ) {
-      ASSERT_COND( mMatrix.verify(mCurSolution) );
-      if ( mBest > cost_so_far ) {
-	mBest = cost_so_far;
-	mBestSolution = mCurSolution;
-	return true;
-      }
-    }
-    return false;
+    return solve_blocks(row_list_array, col_list_array, depth, cur_debug);
   }
 
   // 次の分岐のための列をとってくる．
@@ -259,6 +427,18 @@ McSolverImpl::solve(int lb,
   vector<int> orig_solution(mCurSolution);
 #endif
 
+  // 他のワーカの手が空きそうなら列を選択しない方の分岐をタスクとして渡す．
+  bool split = mPool != nullptr && mPool->hungry();
+  if ( split ) {
+    McTask task;
+    task.mSelectedCols = mCurSolution;
+    task.mExcludedCols = mExcludedCols;
+    task.mExcludedCols.push_back(col);
+    task.mLb = lb;
+    task.mDepth = depth + 1;
+    mPool->push(mWorkerId, std::move(task));
+  }
+
   int cur_n = mCurSolution.size();
   mMatrix.save();
 
@@ -284,12 +464,14 @@ McSolverImpl::solve(int lb,
 #endif
 
   // 今得た最良解が下界と等しかったら探索を続ける必要はない．
-  if ( lb >= mBest ) {
-    return true;
+  // タスクとして渡した場合もここで終わる．
+  if ( split || lb >= bound() ) {
+    return stat1;
   }
 
   // その列を選択しなかったときの最良解を求める．
   mMatrix.delete_col(col);
+  mExcludedCols.push_back(col);
 
   if ( cur_debug ) {
     cout << "delete column#" << col << endl;
@@ -297,44 +479,364 @@ McSolverImpl::solve(int lb,
 
   bool stat2 = solve(lb, depth + 1);
 
+  mExcludedCols.pop_back();
+
   return stat1 || stat2;
 }
 
-// @brief 内部の行列を返す．
-const McMatrix&
-McSolverImpl::matrix() const
+// @brief 縮約コストを用いて列を固定する．
+// @param[in] tmp_cost 現在の解のコスト
+// @return 削除した列の数を返す．
+int
+McSolverImpl::fix_cols(int tmp_cost)
 {
-  return mMatrix;
+  double lb;
+  if ( !mLbCalc.get_reduced_cost(lb, mRcArray) ) {
+    return 0;
+  }
+
+  // 列 col を選ぶ解のコストは tmp_cost + lb + rc 以上になる．
+  int limit = bound() - tmp_cost;
+  mFixList.clear();
+  for ( const McColHead* col = mMatrix.col_front();
+	!mMatrix.is_col_end(col); col = col->next() ) {
+    int col_pos = col->pos();
+    if ( LbCalc::ceil_lb(lb + mRcArray[col_pos]) >= limit ) {
+      mFixList.push_back(col_pos);
+    }
+  }
+
+  for ( auto col_pos: mFixList ) {
+    // delete_col() は空になった行を削除してしまうので
+    // 先に調べておく．
+    const McColHead* col = mMatrix.col(col_pos);
+    for ( const McCell* cell = col->front();
+	  !col->is_end(cell); cell = cell->col_next() ) {
+      if ( mMatrix.row(cell->row_pos())->num() == 1 ) {
+	return -1;
+      }
+    }
+    mMatrix.delete_col(col_pos);
+  }
+
+  return mFixList.size();
 }
 
-// @brief partition フラグを設定する．
-void
-McSolverImpl::set_partition(bool flag)
+// @brief ブロック分割した部分問題を解く．
+// @param[in] row_list_array 各ブロックの行番号のリストの配列
+// @param[in] col_list_array 各ブロックの列番号のリストの配列
+// @param[in] depth 探索の深さ
+// @param[in] cur_debug デバッグフラグ
+//
+// 各ブロックは行列の互いに素な部分を扱うので並列に解くことができる．
+// あるブロックが解き終わったらその最適値を他のブロックの上界に反映させる．
+bool
+McSolverImpl::solve_blocks(const vector<vector<int>>& row_list_array,
+			   const vector<vector<int>>& col_list_array,
+			   int depth,
+			   bool cur_debug)
+{
+  int nb = row_list_array.size();
+
+  // 使えるスレッドを確保する．
+  int nt = 0;
+  if ( !cur_debug ) {
+    int avail = mContext->mFreeThreadNum;
+    for ( ; ; ) {
+      nt = std::min(avail, nb - 1);
+      if ( nt <= 0 ) {
+	nt = 0;
+	break;
+      }
+      if ( mContext->mFreeThreadNum.compare_exchange_weak(avail, avail - nt) ) {
+	break;
+      }
+    }
+  }
+
+  // 並列に解く場合には下界の計算クラスと列を選択するクラスを
+  // ブロックごとに複製する．
+  vector<LbCalc*> lb_calc_list;
+  vector<Selector*> selector_list;
+  vector<McSolverImpl*> solver_list(nb);
+  vector<McMatrix*> matrix_list(nb);
+  for ( int i = 0; i < nb; ++ i ) {
+    if ( nt > 0 ) {
+      lb_calc_list.push_back(mLbCalc.clone());
+      selector_list.push_back(mSelector.clone());
+      solver_list[i] = new McSolverImpl(mMatrix, row_list_array[i], col_list_array[i],
+					*lb_calc_list[i], *selector_list[i], mContext);
+    }
+    else {
+      solver_list[i] = new McSolverImpl(mMatrix, row_list_array[i], col_list_array[i],
+					mLbCalc, mSelector, mContext);
+    }
+    matrix_list[i] = &solver_list[i]->mMatrix;
+  }
+  if ( cur_debug ) {
+    cout << endl
+	 << "BLOCK PARTITION" << endl;
+    for ( int i = 0; i < nb; ++ i ) {
+      cout << "Matrix#" << (i + 1) << endl;
+      solver_list[i]->matrix().print(cout);
+    }
+  }
+
+  // 各ブロックの下界を求めておく．
+  int cost_so_far = mMatrix.cost(mCurSolution);
+  BlockGroup group;
+  group.mBase = bound() - cost_so_far;
+  group.mSum = 0;
+  group.mFailed = false;
+  group.mParent = mGroup;
+  for ( int i = 0; i < nb; ++ i ) {
+    McSolverImpl* solver = solver_list[i];
+    solver->mMatrix.save();
+    solver->mContrib = solver->mLbCalc(solver->matrix());
+    solver->mGroup = &group;
+    solver->mStop = mStop;
+    group.mSum += solver->mContrib;
+  }
+
+  // i 番目のブロックを解く．
+  // mBest の初期値は他のブロックの下界(または最適値)から求める．
+  auto solve_block = [&](int i) {
+    McSolverImpl* solver = solver_list[i];
+    solver->mBest = group.mBase - (group.mSum - solver->mContrib);
+    solver->mCurSolution.clear();
+    if ( solver->solve(0, depth + 1) ) {
+      group.mSum += solver->mBest - solver->mContrib;
+      solver->mContrib = solver->mBest;
+    }
+    else {
+      group.mFailed = true;
+    }
+  };
+
+  if ( nt > 0 ) {
+    // 空いているブロックを順に取ってきて解く．
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+      for ( ; ; ) {
+	int i = next ++;
+	if ( i >= nb || group.mFailed ) {
+	  break;
+	}
+	solve_block(i);
+      }
+    };
+    vector<std::thread> thread_list;
+    thread_list.reserve(nt);
+    for ( int i = 0; i < nt; ++ i ) {
+      thread_list.push_back(std::thread(worker));
+    }
+    worker();
+    for ( auto& th: thread_list ) {
+      th.join();
+    }
+    mContext->mFreeThreadNum += nt;
+  }
+  else {
+    for ( int i = 0; i < nb && !group.mFailed; ++ i ) {
+      solve_block(i);
+    }
+  }
+
+  bool stat1 = !group.mFailed;
+  if ( stat1 ) {
+    for ( auto solver: solver_list ) {
+      mCurSolution.insert(mCurSolution.end(),
+			  solver->mBestSolution.begin(), solver->mBestSolution.end());
+      cost_so_far += solver->mBest;
+    }
+  }
+
+  for ( auto solver: solver_list ) {
+    solver->mMatrix.restore();
+  }
+  mMatrix.merge(matrix_list);
+  for ( auto solver: solver_list ) {
+    delete solver;
+  }
+  for ( auto lb_calc: lb_calc_list ) {
+    delete lb_calc;
+  }
+  for ( auto selector: selector_list ) {
+    delete selector;
+  }
+
+  if ( stat1 ) {
+    ASSERT_COND( mMatrix.verify(mCurSolution) );
+    if ( cost_so_far < bound() ) {
+      update_best(cost_so_far);
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 複数のワーカで並列に解を求める．
+// @param[in] thread_num ワーカ数
+//
+// 各ワーカは行列の複製と下界の計算クラス，列を選択するクラスの複製を持ち，
+// タスクに記録された分岐を適用して部分問題を再構成する．
+// 暫定解は全てのワーカで共有するので枝刈りはすぐに全体に反映される．
+//
+// スレッドは全てワーカに用いるので，ワーカの中では簡単化と
+// ブロック分割の並列化を行わない(McOption::mThreadNum は用いない)．
+bool
+McSolverImpl::solve_parallel(int thread_num)
 {
-  mDoPartition = flag;
+  McOption worker_option(mContext->mOption);
+  worker_option.mThreadNum = 1;
+  Context worker_context(worker_option);
+
+  McIncumbent incumbent;
+  McTaskPool pool(thread_num);
+
+  // 根のタスク
+  McTask root;
+  root.mLb = 0;
+  root.mDepth = 0;
+  pool.push(0, std::move(root));
+
+  vector<LbCalc*> lb_calc_list(thread_num);
+  vector<Selector*> selector_list(thread_num);
+  vector<McSolverImpl*> worker_list(thread_num);
+  for ( int i = 0; i < thread_num; ++ i ) {
+    lb_calc_list[i] = mLbCalc.clone();
+    selector_list[i] = mSelector.clone();
+    McSolverImpl* worker = new McSolverImpl(mMatrix, *lb_calc_list[i], *selector_list[i],
+					    &worker_context);
+    worker->mBest = INT_MAX;
+    worker->mIncumbent = &incumbent;
+    worker->mPool = &pool;
+    worker->mWorkerId = i;
+    worker_list[i] = worker;
+  }
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(thread_num - 1);
+  for ( int i = 1; i < thread_num; ++ i ) {
+    thread_list.push_back(std::thread(&McSolverImpl::run_worker, worker_list[i]));
+  }
+  worker_list[0]->run_worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  mContext->mSolveId += worker_context.mSolveId;
+
+  for ( auto worker: worker_list ) {
+    delete worker;
+  }
+  for ( auto lb_calc: lb_calc_list ) {
+    delete lb_calc;
+  }
+  for ( auto selector: selector_list ) {
+    delete selector;
+  }
+
+  if ( incumbent.cost() == INT_MAX ) {
+    return false;
+  }
+  mBest = incumbent.cost();
+  mBestSolution = incumbent.solution();
+  return true;
 }
 
-// @brief デバッグフラグを設定する．
+// @brief ワーカとしてタスクプールのタスクを処理する．
 void
-McSolverImpl::set_debug(bool flag)
+McSolverImpl::run_worker()
 {
-  mDebug = flag;
+  // タスクがない間は pop() の中で眠っている．
+  McTask task;
+  while ( mPool->pop(mWorkerId, task) ) {
+    // 分岐を適用して部分問題を作る．
+    mMatrix.save();
+    for ( auto col: task.mSelectedCols ) {
+      mMatrix.select_col(col);
+    }
+    for ( auto col: task.mExcludedCols ) {
+      mMatrix.delete_col(col);
+    }
+    mCurSolution = task.mSelectedCols;
+    mExcludedCols = task.mExcludedCols;
+
+    solve(task.mLb, task.mDepth);
+
+    mMatrix.restore();
+    mPool->done();
+  }
 }
 
-// @brief mMaxDepth を設定する．
+// @brief 現在の解で最良解を更新する．
+// @param[in] cost 現在の解のコスト
 void
-McSolverImpl::set_max_depth(int depth)
+McSolverImpl::update_best(int cost)
 {
-  mMaxDepth = depth;
+  mBest = cost;
+  mBestSolution = mCurSolution;
+  if ( mIncumbent != nullptr ) {
+    mIncumbent->update(cost, mCurSolution);
+  }
 }
 
-bool
-McSolverImpl::mDoPartition = true;
+// @brief 現在の上界を返す．
+//
+// ブロック分割の一部を解いている場合には
+// 兄弟のブロックの結果を反映させる．
+// 並列探索の場合には他のワーカの結果を反映させる．
+int
+McSolverImpl::bound() const
+{
+  int b = mBest;
+  if ( mIncumbent != nullptr ) {
+    b = std::min(b, mIncumbent->cost());
+  }
+  if ( mGroup != nullptr ) {
+    b = std::min(b, mGroup->mBase - (mGroup->mSum - mContrib));
+  }
+  return b;
+}
 
+// @brief 探索を打ち切るべき時 true を返す．
+//
+// portfolio() で他のスレッドが探索を終えた時と，
+// ブロック分割で兄弟のブロックが失敗した時に true となる．
 bool
-McSolverImpl::mDebug = false;
+McSolverImpl::aborted() const
+{
+  if ( mStop != nullptr && *mStop ) {
+    return true;
+  }
+  for ( const BlockGroup* group = mGroup; group != nullptr;
+	group = group->mParent ) {
+    if ( group->mFailed ) {
+      return true;
+    }
+  }
+  return false;
+}
 
-int
-McSolverImpl::mMaxDepth = 0;
+// @brief 内部の行列を返す．
+const McMatrix&
+McSolverImpl::matrix() const
+{
+  return mMatrix;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス McSolverImpl::Context
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] option オプション
+McSolverImpl::Context::Context(const McOption& option) :
+  mOption(option),
+  mSolveId(0),
+  mFreeThreadNum(option.mThreadNum > 1 ? option.mThreadNum - 1 : 0)
+{
+}
 
 END_NAMESPACE_YM_MINCOV
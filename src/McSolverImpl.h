@@ -13,6 +13,8 @@
 #include "McMatrix.h"
 #include "LbCalc.h"
 #include "Selector.h"
+#include "McOption.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -29,21 +31,11 @@ public:
   /// @param[in] matrix 問題の行列
   /// @param[in] lb_calc 下界の計算クラス
   /// @param[in] selector 列を選択するクラス
+  /// @param[in] option オプション
   McSolverImpl(const McMatrix& matrix,
 	       LbCalc& lb_calc,
-	       Selector& selector);
-
-  /// @brief コンストラクタ
-  /// @param[in] matrix 問題の行列
-  /// @param[in] row_list 注目する行番号のリスト
-  /// @param[in] col_list 注目する列番号のリスト
-  /// @param[in] lb_calc 下界の計算クラス
-  /// @param[in] selector 列を選択するクラス
-  McSolverImpl(McMatrix& matrix,
-	       const vector<int>& row_list,
-	       const vector<int>& col_list,
-	       LbCalc& lb_calc,
-	       Selector& selector);
+	       Selector& selector,
+	       const McOption& option);
 
   /// @brief デストラクタ
   ~McSolverImpl();
@@ -56,28 +48,83 @@ public:
 
   /// @brief 最小被覆問題を解く．
   /// @param[out] solution 選ばれた列集合
+  /// @param[in] thread_num 探索に用いるスレッド数
   /// @return 解のコスト
+  ///
+  /// thread_num が 2 以上の時は部分木をタスクとして
+  /// 複数のワーカで並列に探索する．この時はスレッドを全て
+  /// ワーカに用いるので McOption::mThreadNum は用いない．
   int
-  exact(vector<int>& solution);
+  exact(vector<int>& solution,
+	int thread_num);
+
+  /// @brief 複数の設定で並列に探索する．
+  /// @param[in] matrix 問題の行列
+  /// @param[in] lb_calc_list 下界の計算クラスのリスト
+  /// @param[in] selector_list 列を選択するクラスのリスト
+  /// @param[in] option オプション
+  /// @param[out] solution 選ばれた列集合
+  /// @return 解のコスト
+  ///
+  /// lb_calc_list[i] と selector_list[i] の組み合わせごとに
+  /// スレッドを一つ用いる．暫定解は全てのスレッドで共有し，
+  /// いずれかのスレッドが探索を終えた時点で全体を打ち切る．
+  static
+  int
+  portfolio(const McMatrix& matrix,
+	    const vector<LbCalc*>& lb_calc_list,
+	    const vector<Selector*>& selector_list,
+	    const McOption& option,
+	    vector<int>& solution);
 
   /// @brief 内部の行列を返す．
   const McMatrix&
   matrix() const;
 
-  /// @brief partition フラグを設定する．
-  static
-  void
-  set_partition(bool flag);
 
-  /// @brief デバッグフラグを設定する．
-  static
-  void
-  set_debug(bool flag);
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
 
-  /// @brief mMaxDepth を設定する．
-  static
-  void
-  set_max_depth(int depth);
+  /// @brief 一回の求解の中で全ての McSolverImpl が共有する情報
+  ///
+  /// ブロック分割や並列探索で作られる McSolverImpl も
+  /// 元の McSolverImpl と同じものを参照する．
+  struct Context
+  {
+    /// @brief コンストラクタ
+    /// @param[in] option オプション
+    Context(const McOption& option);
+
+    // オプション
+    const McOption& mOption;
+
+    // 探索したノード数
+    std::atomic<int> mSolveId;
+
+    // ブロックの並列処理に使えるスレッドの残り数
+    std::atomic<int> mFreeThreadNum;
+  };
+
+  /// @brief ブロック分割した各ブロックが共有する情報
+  ///
+  /// mSum は各ブロックの下界の和だが，解き終わったブロックの項は
+  /// そのブロックの最適値に置き換えられる．
+  struct BlockGroup
+  {
+    // 親の上界から選択済みのコストを引いたもの
+    int mBase;
+
+    // 各ブロックの下界(または最適値)の和
+    std::atomic<int> mSum;
+
+    // いずれかのブロックで解が得られなかった時 true になるフラグ
+    std::atomic<bool> mFailed;
+
+    // 親のグループ
+    const BlockGroup* mParent;
+  };
 
 
 private:
@@ -85,11 +132,89 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 並列探索のワーカ用のコンストラクタ
+  /// @param[in] matrix 問題の行列
+  /// @param[in] lb_calc 下界の計算クラス
+  /// @param[in] selector 列を選択するクラス
+  /// @param[in] context 共有する情報
+  McSolverImpl(const McMatrix& matrix,
+	       LbCalc& lb_calc,
+	       Selector& selector,
+	       Context* context);
+
+  /// @brief ブロック分割用のコンストラクタ
+  /// @param[in] matrix 問題の行列
+  /// @param[in] row_list 注目する行番号のリスト
+  /// @param[in] col_list 注目する列番号のリスト
+  /// @param[in] lb_calc 下界の計算クラス
+  /// @param[in] selector 列を選択するクラス
+  /// @param[in] context 共有する情報
+  McSolverImpl(McMatrix& matrix,
+	       const vector<int>& row_list,
+	       const vector<int>& col_list,
+	       LbCalc& lb_calc,
+	       Selector& selector,
+	       Context* context);
+
+  /// @brief 下界の計算で用いるものを行列に持たせる．
+  ///
+  /// 各コンストラクタから呼ばれる．
+  void
+  attach_listeners();
+
   /// @brief 解を求める再帰関数
   bool
   solve(int lb,
 	int depth);
 
+  /// @brief 縮約コストを用いて列を固定する．
+  /// @param[in] tmp_cost 現在の解のコスト
+  /// @return 削除した列の数を返す．
+  ///
+  /// 下界の計算クラスが縮約コストを持つ時，選ぶと bound() 以上の
+  /// コストになる列を削除する．削除は行列の削除スタックに積まれる．
+  /// 削除すると被覆できなくなる行があればこの節点には
+  /// bound() より良い解がないので -1 を返す．
+  int
+  fix_cols(int tmp_cost);
+
+  /// @brief ブロック分割した部分問題を解く．
+  /// @param[in] row_list_array 各ブロックの行番号のリストの配列
+  /// @param[in] col_list_array 各ブロックの列番号のリストの配列
+  /// @param[in] depth 探索の深さ
+  /// @param[in] cur_debug デバッグフラグ
+  bool
+  solve_blocks(const vector<vector<int>>& row_list_array,
+	       const vector<vector<int>>& col_list_array,
+	       int depth,
+	       bool cur_debug);
+
+  /// @brief 複数のワーカで並列に解を求める．
+  /// @param[in] thread_num ワーカ数
+  bool
+  solve_parallel(int thread_num);
+
+  /// @brief ワーカとしてタスクプールのタスクを処理する．
+  void
+  run_worker();
+
+  /// @brief 現在の解で最良解を更新する．
+  /// @param[in] cost 現在の解のコスト
+  void
+  update_best(int cost);
+
+  /// @brief 現在の上界を返す．
+  ///
+  /// ブロック分割の一部を解いている場合には
+  /// 兄弟のブロックの結果を反映させる．
+  /// 並列探索の場合には他のワーカの結果を反映させる．
+  int
+  bound() const;
+
+  /// @brief 探索を打ち切るべき時 true を返す．
+  bool
+  aborted() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -114,17 +239,39 @@ private:
   // 現在の解
   vector<int> mCurSolution;
 
-  // block_partition を行うとき true にするフラグ
-  static
-  bool mDoPartition;
+  // 自分が属しているブロックのグループ
+  BlockGroup* mGroup;
 
-  // デバッグフラグ
-  static
-  bool mDebug;
+  // mGroup->mSum に含まれる自分の下界
+  int mContrib;
 
-  // デバッグで表示する最大深さ
-  static
-  int mMaxDepth;
+  // 現在の解で削除されている列のリスト
+  // 並列探索でタスクを作るために用いる．
+  vector<int> mExcludedCols;
+
+  // fix_cols() で用いる縮約コストの配列
+  vector<double> mRcArray;
+
+  // fix_cols() で用いる列のリスト
+  vector<int> mFixList;
+
+  // 並列探索で共有する暫定解
+  McIncumbent* mIncumbent;
+
+  // 並列探索のタスクプール
+  McTaskPool* mPool;
+
+  // 並列探索でのワーカ番号
+  int mWorkerId;
+
+  // 探索を打ち切る時に true になるフラグ
+  const std::atomic<bool>* mStop;
+
+  // 共有する情報
+  Context* mContext;
+
+  // mContext を自分で確保した時 true にするフラグ
+  bool mOwnContext;
 
 };
 
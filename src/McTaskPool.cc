@@ -0,0 +1,140 @@
+﻿
+/// @file McTaskPool.cc
+/// @brief McTaskPool の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "McTaskPool.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス McTaskPool
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] worker_num ワーカ数
+McTaskPool::McTaskPool(int worker_num) :
+  mWorkerNum(worker_num),
+  mQueueArray(new Queue[worker_num]),
+  mQueuedNum(0),
+  mPendingNum(0)
+{
+}
+
+// @brief デストラクタ
+McTaskPool::~McTaskPool()
+{
+  delete [] mQueueArray;
+}
+
+// @brief タスクを追加する．
+// @param[in] worker_id 追加するワーカの番号
+// @param[in] task タスク
+void
+McTaskPool::push(int worker_id,
+		 McTask&& task)
+{
+  // 先に mPendingNum を増やしておかないと
+  // 他のワーカが終了したと誤認する可能性がある．
+  ++ mPendingNum;
+  Queue& queue = mQueueArray[worker_id];
+  {
+    std::lock_guard<std::mutex> lock(queue.mMutex);
+    queue.mTaskList.push_back(std::move(task));
+    ++ mQueuedNum;
+  }
+  wake_up(false);
+}
+
+// @brief タスクを取り出す．
+// @param[in] worker_id 取り出すワーカの番号
+// @param[out] task 取り出したタスク
+// @retval true 取り出せた．
+// @retval false 全てのタスクの処理が終わった．
+bool
+McTaskPool::pop(int worker_id,
+		McTask& task)
+{
+  for ( ; ; ) {
+    if ( try_pop(worker_id, task) ) {
+      return true;
+    }
+    // mQueuedNum と mPendingNum は mMutex を取ってから調べるので，
+    // 調べてから wait() するまでの間の通知を取りこぼすことはない．
+    std::unique_lock<std::mutex> lock(mMutex);
+    if ( mPendingNum == 0 ) {
+      return false;
+    }
+    if ( mQueuedNum == 0 ) {
+      mCond.wait(lock);
+    }
+  }
+}
+
+// @brief pop() で取り出したタスクの処理が終わったことを知らせる．
+void
+McTaskPool::done()
+{
+  if ( -- mPendingNum == 0 ) {
+    wake_up(true);
+  }
+}
+
+// @brief 待たずにタスクを取り出す．
+// @param[in] worker_id 取り出すワーカの番号
+// @param[out] task 取り出したタスク
+// @retval true 取り出せた．
+// @retval false どのキューも空だった．
+bool
+McTaskPool::try_pop(int worker_id,
+		    McTask& task)
+{
+  { // 自分のキューの末尾から取り出す．
+    Queue& queue = mQueueArray[worker_id];
+    std::lock_guard<std::mutex> lock(queue.mMutex);
+    if ( !queue.mTaskList.empty() ) {
+      task = std::move(queue.mTaskList.back());
+      queue.mTaskList.pop_back();
+      -- mQueuedNum;
+      return true;
+    }
+  }
+
+  // 他のワーカのキューの先頭から盗む．
+  for ( int i = 1; i < mWorkerNum; ++ i ) {
+    Queue& queue = mQueueArray[(worker_id + i) % mWorkerNum];
+    std::lock_guard<std::mutex> lock(queue.mMutex);
+    if ( !queue.mTaskList.empty() ) {
+      task = std::move(queue.mTaskList.front());
+      queue.mTaskList.pop_front();
+      -- mQueuedNum;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// @brief 待っているワーカを起こす．
+// @param[in] all 全てのワーカを起こす時 true にする．
+//
+// pop() が条件を調べてから wait() するまでの間に通知しないように
+// mMutex を取ってから通知する．
+void
+McTaskPool::wake_up(bool all)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if ( all ) {
+    mCond.notify_all();
+  }
+  else {
+    mCond.notify_one();
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
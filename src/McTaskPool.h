@@ -0,0 +1,192 @@
+﻿#ifndef MCTASKPOOL_H
+#define MCTASKPOOL_H
+
+/// @file McTaskPool.h
+/// @brief McTaskPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2005-2011, 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McTask McTaskPool.h "McTaskPool.h"
+/// @brief 並列探索で他のワーカに渡す部分問題
+///
+/// 行列そのものは持たず，根からの分岐で選択した列と
+/// 削除した列のみを持つ．受け取ったワーカはこれを元の行列に
+/// 適用して部分問題を再構成する．
+//////////////////////////////////////////////////////////////////////
+struct McTask
+{
+  // 選択された列のリスト
+  vector<int> mSelectedCols;
+
+  // 削除された列のリスト
+  vector<int> mExcludedCols;
+
+  // 下界
+  int mLb;
+
+  // 探索の深さ
+  int mDepth;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class McTaskPool McTaskPool.h "McTaskPool.h"
+/// @brief work stealing 方式のタスクプール
+///
+/// ワーカごとに両端キューを持ち，自分のキューからは末尾から
+/// (深さ優先に)取り出し，他のワーカのキューからは先頭から
+/// (根に近い大きな部分問題を)盗む．
+///
+/// タスクのないワーカは pop() の中で眠り，タスクが追加されるか
+/// 全てのタスクの処理が終わった時に起こされる．
+//////////////////////////////////////////////////////////////////////
+class McTaskPool
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] worker_num ワーカ数
+  McTaskPool(int worker_num);
+
+  /// @brief デストラクタ
+  ~McTaskPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ワーカ数を返す．
+  int
+  worker_num() const;
+
+  /// @brief タスクを追加する．
+  /// @param[in] worker_id 追加するワーカの番号
+  /// @param[in] task タスク
+  void
+  push(int worker_id,
+       McTask&& task);
+
+  /// @brief タスクを取り出す．
+  /// @param[in] worker_id 取り出すワーカの番号
+  /// @param[out] task 取り出したタスク
+  /// @retval true 取り出せた．
+  /// @retval false 全てのタスクの処理が終わった．
+  ///
+  /// どのキューも空の時はタスクが追加されるか
+  /// 全てのタスクの処理が終わるまで待つ．
+  /// 取り出したタスクの処理が終わったら done() を呼ぶこと．
+  bool
+  pop(int worker_id,
+      McTask& task);
+
+  /// @brief pop() で取り出したタスクの処理が終わったことを知らせる．
+  void
+  done();
+
+  /// @brief タスクが足りない時 true を返す．
+  ///
+  /// キューに入っているタスク数がワーカ数より少ない時に true となる．
+  bool
+  hungry() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 待たずにタスクを取り出す．
+  /// @param[in] worker_id 取り出すワーカの番号
+  /// @param[out] task 取り出したタスク
+  /// @retval true 取り出せた．
+  /// @retval false どのキューも空だった．
+  bool
+  try_pop(int worker_id,
+	  McTask& task);
+
+  /// @brief 待っているワーカを起こす．
+  /// @param[in] all 全てのワーカを起こす時 true にする．
+  void
+  wake_up(bool all);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ワーカごとのキュー
+  struct Queue
+  {
+    // mTaskList を保護する mutex
+    std::mutex mMutex;
+
+    // タスクのリスト
+    std::deque<McTask> mTaskList;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ワーカ数
+  int mWorkerNum;
+
+  // キューの配列
+  Queue* mQueueArray;
+
+  // キューに入っているタスク数
+  std::atomic<int> mQueuedNum;
+
+  // 追加されてからまだ処理の終わっていないタスク数
+  std::atomic<int> mPendingNum;
+
+  // mCond で待つための mutex
+  std::mutex mMutex;
+
+  // タスクの追加と全てのタスクの終了を知らせる条件変数
+  std::condition_variable mCond;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ワーカ数を返す．
+inline
+int
+McTaskPool::worker_num() const
+{
+  return mWorkerNum;
+}
+
+// @brief タスクが足りない時 true を返す．
+inline
+bool
+McTaskPool::hungry() const
+{
+  return mQueuedNum < mWorkerNum;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MCTASKPOOL_H
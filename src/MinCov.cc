@@ -9,7 +9,6 @@
 
 #include "ym/MinCov.h"
 #include "McSolver.h"
-#include "McSolverImpl.h"
 
 
 BEGIN_NAMESPACE_YM
@@ -60,13 +59,59 @@ MinCov::insert_elem(int row_pos,
   mSolver->insert_elem(row_pos, col_pos);
 }
 
+// @brief CSR 形式で問題を設定する．
+// @param[in] row_ptr 各行の要素の開始位置の配列 ( サイズは行数 + 1 )
+// @param[in] col_idx 要素の列番号の配列
+// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+void
+MinCov::load_csr(const vector<int>& row_ptr,
+		 const vector<int>& col_idx,
+		 const vector<int>& col_cost_array)
+{
+  mSolver->load_csr(row_ptr, col_idx, col_cost_array);
+}
+
+// @brief COO 形式で問題を設定する．
+// @param[in] row_size 行数
+// @param[in] row_idx 要素の行番号の配列
+// @param[in] col_idx 要素の列番号の配列
+// @param[in] col_cost_array 列のコストの配列 ( サイズは列数 )
+void
+MinCov::load_coo(int row_size,
+		 const vector<int>& row_idx,
+		 const vector<int>& col_idx,
+		 const vector<int>& col_cost_array)
+{
+  mSolver->load_coo(row_size, row_idx, col_idx, col_cost_array);
+}
+
 // @brief 最小被覆問題を解く．
 // @param[out] solution 選ばれた列集合
 // @return 解のコスト
 int
 MinCov::exact(vector<int>& solution)
 {
-  return mSolver->exact(solution);
+  return mSolver->exact(solution, 1);
+}
+
+// @brief 複数のスレッドで最小被覆問題を解く．
+// @param[out] solution 選ばれた列集合
+// @param[in] thread_num 探索に用いるスレッド数
+// @return 解のコスト
+int
+MinCov::exact(vector<int>& solution,
+	      int thread_num)
+{
+  return mSolver->exact(solution, thread_num);
+}
+
+// @brief 複数の設定を並列に走らせて最小被覆問題を解く．
+// @param[out] solution 選ばれた列集合
+// @return 解のコスト
+int
+MinCov::exact_portfolio(vector<int>& solution)
+{
+  return mSolver->exact_portfolio(solution);
 }
 
 // @brief ヒューリスティックで最小被覆問題を解く．
@@ -92,25 +137,68 @@ MinCov::heuristic(const string& algorithm,
   return mSolver->heuristic(algorithm, solution);
 }
 
+// @brief ヒューリスティックで最小被覆問題を解き，下界も求める．
+// @param[in] algorithm ヒューリスティックの名前
+// @param[out] solution 選ばれた列集合
+// @param[out] lower_bound 最適解のコストの下界
+// @return 解のコスト
+int
+MinCov::heuristic(const string& algorithm,
+		  vector<int>& solution,
+		  int& lower_bound)
+{
+  return mSolver->heuristic(algorithm, solution, lower_bound);
+}
+
 // @brief partition フラグを設定する．
 void
 MinCov::set_partition_flag(bool flag)
 {
-  nsMincov::McSolverImpl::set_partition(flag);
+  mSolver->option().mDoPartition = flag;
 }
 
 // @brief デバッグフラグを設定する．
 void
 MinCov::set_debug_flag(bool flag)
 {
-  nsMincov::McSolverImpl::set_debug(flag);
+  mSolver->option().mDebug = flag;
 }
 
 // @brief デバッグで表示する最大深さを設定する．
 void
 MinCov::set_max_depth(int depth)
 {
-  nsMincov::McSolverImpl::set_max_depth(depth);
+  mSolver->option().mMaxDepth = depth;
+}
+
+// @brief 並列処理に用いるスレッド数を設定する．
+void
+MinCov::set_thread_num(int num)
+{
+  mSolver->option().mThreadNum = num;
+}
+
+// @brief 下界の計算を並列に行うかを設定する．
+void
+MinCov::set_parallel_lb(bool flag)
+{
+  mSolver->option().mParallelLb = flag;
+}
+
+// @brief exact() で用いる下界の計算方法を設定する．
+// @param[in] name_list 下界の計算方法の名前のリスト
+void
+MinCov::set_lb_list(const vector<string>& name_list)
+{
+  mSolver->set_lb_list(name_list);
+}
+
+// @brief MIS 下界の局所探索の反復回数を設定する．
+// @param[in] iter_num 反復回数
+void
+MinCov::set_mis_ls_iter_num(int iter_num)
+{
+  mSolver->set_mis_ls_iter_num(iter_num);
 }
 
 END_NAMESPACE_YM
@@ -0,0 +1,296 @@
+﻿#ifndef MISBUCKETQUEUE_H
+#define MISBUCKETQUEUE_H
+
+/// @file MisBucketQueue.h
+/// @brief MisBucketQueue のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2014 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym/ym_mincov.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class MisBucketQueue MisBucketQueue.h "MisBucketQueue.h"
+/// @brief MIS の貪欲法で用いるバケットキュー
+///
+/// 要素は 0 から始まる番号で表し，値(隣接するノード数)ごとに
+/// 双方向リンクトリストのバケットにつなぐ．
+/// 値は減る方向にしか変わらないので最小値の位置を覚えておけば
+/// 最小要素の取り出しも値の減少も(ならし)定数時間で行える．
+/// 同じ値の要素は後から追加(または値を更新)したものが先に取り出される．
+//////////////////////////////////////////////////////////////////////
+class MisBucketQueue
+{
+public:
+
+  /// @brief コンストラクタ
+  MisBucketQueue();
+
+  /// @brief デストラクタ
+  ~MisBucketQueue();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  /// @param[in] size 要素番号の最大値 + 1
+  /// @param[in] max_key 値の最大値
+  ///
+  /// キューは空になる．
+  void
+  init(int size,
+       int max_key);
+
+  /// @brief キューが空の時 true を返す．
+  bool
+  empty() const;
+
+  /// @brief 要素がキューに含まれている時 true を返す．
+  /// @param[in] id 要素番号 ( 0 <= id < size )
+  bool
+  in_queue(int id) const;
+
+  /// @brief 要素の値を返す．
+  /// @param[in] id 要素番号 ( 0 <= id < size )
+  int
+  key(int id) const;
+
+  /// @brief 要素を追加する．
+  /// @param[in] id 要素番号 ( 0 <= id < size )
+  /// @param[in] key 値 ( 0 <= key <= max_key )
+  void
+  put(int id,
+      int key);
+
+  /// @brief 値が最小の要素を取り出す．
+  ///
+  /// その要素はキューから取り除かれる．
+  int
+  get_min();
+
+  /// @brief 要素を取り除く．
+  /// @param[in] id 要素番号
+  void
+  erase(int id);
+
+  /// @brief 要素の値を減らす．
+  /// @param[in] id 要素番号
+  /// @param[in] num 減らす量 ( 0 < num <= key(id) )
+  void
+  dec_key(int id,
+	  int num);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素を値に対応するバケットの先頭につなぐ．
+  void
+  link(int id);
+
+  /// @brief 要素をバケットから外す．
+  void
+  unlink(int id);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素の情報
+  struct Elem
+  {
+    // 値
+    // キューに含まれない要素は -1 となる．
+    int mKey;
+
+    // バケット中の直前の要素
+    int mPrev;
+
+    // バケット中の直後の要素
+    int mNext;
+  };
+
+  // 要素の配列
+  vector<Elem> mElemArray;
+
+  // 各バケットの先頭の要素の配列
+  vector<int> mHead;
+
+  // 空でないバケットの値の下限
+  int mMinKey;
+
+  // キューに含まれる要素数
+  int mNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+MisBucketQueue::MisBucketQueue() :
+  mMinKey(0),
+  mNum(0)
+{
+}
+
+// @brief デストラクタ
+inline
+MisBucketQueue::~MisBucketQueue()
+{
+}
+
+// @brief 初期化する．
+// @param[in] size 要素番号の最大値 + 1
+// @param[in] max_key 値の最大値
+inline
+void
+MisBucketQueue::init(int size,
+		     int max_key)
+{
+  mElemArray.resize(size);
+  for ( auto& elem: mElemArray ) {
+    elem.mKey = -1;
+  }
+  mHead.assign(max_key + 1, -1);
+  mMinKey = 0;
+  mNum = 0;
+}
+
+// @brief キューが空の時 true を返す．
+inline
+bool
+MisBucketQueue::empty() const
+{
+  return mNum == 0;
+}
+
+// @brief 要素がキューに含まれている時 true を返す．
+// @param[in] id 要素番号 ( 0 <= id < size )
+inline
+bool
+MisBucketQueue::in_queue(int id) const
+{
+  return mElemArray[id].mKey >= 0;
+}
+
+// @brief 要素の値を返す．
+// @param[in] id 要素番号 ( 0 <= id < size )
+inline
+int
+MisBucketQueue::key(int id) const
+{
+  return mElemArray[id].mKey;
+}
+
+// @brief 要素を追加する．
+// @param[in] id 要素番号 ( 0 <= id < size )
+// @param[in] key 値 ( 0 <= key <= max_key )
+inline
+void
+MisBucketQueue::put(int id,
+		    int key)
+{
+  ASSERT_COND( !in_queue(id) );
+  mElemArray[id].mKey = key;
+  link(id);
+  if ( mMinKey > key ) {
+    mMinKey = key;
+  }
+  ++ mNum;
+}
+
+// @brief 値が最小の要素を取り出す．
+inline
+int
+MisBucketQueue::get_min()
+{
+  ASSERT_COND( !empty() );
+  while ( mHead[mMinKey] == -1 ) {
+    ++ mMinKey;
+  }
+  int id = mHead[mMinKey];
+  erase(id);
+  return id;
+}
+
+// @brief 要素を取り除く．
+// @param[in] id 要素番号
+inline
+void
+MisBucketQueue::erase(int id)
+{
+  ASSERT_COND( in_queue(id) );
+  unlink(id);
+  mElemArray[id].mKey = -1;
+  -- mNum;
+}
+
+// @brief 要素の値を減らす．
+// @param[in] id 要素番号
+// @param[in] num 減らす量 ( 0 < num <= key(id) )
+inline
+void
+MisBucketQueue::dec_key(int id,
+			int num)
+{
+  Elem& elem = mElemArray[id];
+  ASSERT_COND( num > 0 && elem.mKey >= num );
+  unlink(id);
+  elem.mKey -= num;
+  link(id);
+  if ( mMinKey > elem.mKey ) {
+    mMinKey = elem.mKey;
+  }
+}
+
+// @brief 要素を値に対応するバケットの先頭につなぐ．
+inline
+void
+MisBucketQueue::link(int id)
+{
+  Elem& elem = mElemArray[id];
+  int& head = mHead[elem.mKey];
+  elem.mPrev = -1;
+  elem.mNext = head;
+  if ( head != -1 ) {
+    mElemArray[head].mPrev = id;
+  }
+  head = id;
+}
+
+// @brief 要素をバケットから外す．
+inline
+void
+MisBucketQueue::unlink(int id)
+{
+  const Elem& elem = mElemArray[id];
+  if ( elem.mPrev == -1 ) {
+    mHead[elem.mKey] = elem.mNext;
+  }
+  else {
+    mElemArray[elem.mPrev].mNext = elem.mNext;
+  }
+  if ( elem.mNext != -1 ) {
+    mElemArray[elem.mNext].mPrev = elem.mPrev;
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MISBUCKETQUEUE_H
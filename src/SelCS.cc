@@ -9,6 +9,7 @@
 
 #include "SelCS.h"
 #include "McMatrix.h"
+#include "LbCS.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -27,23 +28,12 @@ SelCS::operator()(const McMatrix& matrix)
   // その重みの和が最大となる列を選ぶ．
   int nr = matrix.row_size();
   vector<double> row_weights(nr);
-  for ( const McRowHead* row = matrix.row_front();
-	!matrix.is_row_end(row); row = row->next() ) {
-    int row_pos = row->pos();
-    double min_cost = DBL_MAX;
-    for (const McCell* cell = row->front();
-	 !row->is_end(cell); cell = cell->row_next()) {
-      const McColHead* col = matrix.col(cell->col_pos());
-      double col_cost = static_cast<double>(matrix.col_cost(col->pos())) / col->num();
-      if ( min_cost > col_cost ) {
-	min_cost = col_cost;
-      }
-    }
-    row_weights[row_pos] = min_cost;
-  }
+  LbCS::row_weights(matrix, row_weights);
 
+  // 全ての列の delta_sum が無限大になることもあるので
+  // min_col の初期値には最初の列を用いる．
   double min_delta = DBL_MAX;
-  int min_col = 0;
+  int min_col = -1;
 
   for (const McColHead* col = matrix.col_front();
        !matrix.is_col_end(col); col = col->next()) {
@@ -106,7 +96,7 @@ SelCS::operator()(const McMatrix& matrix)
     }
 
     //cout << "Col#" << col->pos() << ": " << delta_sum << endl;
-    if ( min_delta > delta_sum ) {
+    if ( min_col == -1 || min_delta > delta_sum ) {
       min_delta = delta_sum;
       min_col = col_pos;
     }
@@ -114,4 +104,11 @@ SelCS::operator()(const McMatrix& matrix)
   return min_col;
 }
 
+// @brief 自身の複製を作る．
+Selector*
+SelCS::clone() const
+{
+  return new SelCS();
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -36,6 +36,11 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 自身の複製を作る．
+  virtual
+  Selector*
+  clone() const;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -36,4 +36,11 @@ SelNaive::operator()(const McMatrix& matrix)
   return max_col;
 }
 
+// @brief 自身の複製を作る．
+Selector*
+SelNaive::clone() const
+{
+  return new SelNaive();
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -9,6 +9,7 @@
 
 #include "SelSimple.h"
 #include "McMatrix.h"
+#include "McColScore.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -23,6 +24,11 @@ BEGIN_NAMESPACE_YM_MINCOV
 int
 SelSimple::operator()(const McMatrix& matrix)
 {
+  McColScore* col_score = matrix.col_score();
+  if ( col_score != nullptr ) {
+    return col_score->max_col(matrix);
+  }
+
   // 各行にカバーしている列数に応じた重みをつけ，
   // その重みの和が最大となる列を選ぶ．
   double max_weight = 0.0;
@@ -45,4 +51,18 @@ SelSimple::operator()(const McMatrix& matrix)
   return max_col;
 }
 
+// @brief 自身の複製を作る．
+Selector*
+SelSimple::clone() const
+{
+  return new SelSimple();
+}
+
+// @brief 列の評価値を用いる時 true を返す．
+bool
+SelSimple::need_col_score() const
+{
+  return true;
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -20,6 +20,9 @@ BEGIN_NAMESPACE_YM_MINCOV
 ///
 /// 各行にカバーしている列数に応じた重みをつけ，
 /// その重みの和が最大となる列を選ぶ．
+///
+/// 行列が McColScore を持っていれば，差分更新されている
+/// ヒープの根の列を返すので行列を走査しない．
 //////////////////////////////////////////////////////////////////////
 class SelSimple :
   public Selector
@@ -36,6 +39,16 @@ public:
   int
   operator()(const McMatrix& matrix);
 
+  /// @brief 自身の複製を作る．
+  virtual
+  Selector*
+  clone() const;
+
+  /// @brief 列の評価値を用いる時 true を返す．
+  virtual
+  bool
+  need_col_score() const;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -39,8 +39,38 @@ public:
   int
   operator()(const McMatrix& matrix) = 0;
 
+  /// @brief 自身の複製を作る．
+  ///
+  /// 並列に探索する時にスレッドごとに別のオブジェクトを用いるためのもの
+  virtual
+  Selector*
+  clone() const = 0;
+
+  /// @brief 列の評価値を用いる時 true を返す．
+  ///
+  /// true を返す時は McSolver::greedy() が行列に
+  /// McMatrix::make_col_score() で列の評価値を持たせる．
+  /// 分枝限定法では毎回走査する方が速かったので持たせない．
+  /// デフォルトでは false を返す．
+  virtual
+  bool
+  need_col_score() const;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 列の評価値を用いる時 true を返す．
+inline
+bool
+Selector::need_col_score() const
+{
+  return false;
+}
+
 END_NAMESPACE_YM_MINCOV
 
 